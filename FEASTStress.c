@@ -0,0 +1,238 @@
+/*******************************************************************************
+** FEASTStress.c
+** A stress test for the thread safety of the FEAST functions. Several POSIX
+** threads run every criterion, the dataset* and weighted functions, with and
+** without OpenMP threads of their own, at once on one shared feature matrix,
+** class column, weight vector and FEASTDataset. Each result is compared
+** bitwise against a serial run made before the threads start.
+**
+** Built and run by "make stress". Usage: FEASTStress [threads] [rounds]
+** Returns 0 if every concurrent run matched the serial one.
+**
+** Author: Adam Pocock
+** Created: 17/10/2026
+**
+** Part of the FEAture Selection Toolbox (FEAST), please reference
+** "Conditional Likelihood Maximisation: A Unifying Framework for Information
+** Theoretic Feature Selection"
+** G. Brown, A. Pocock, M.-J. Zhao, M. Lujan
+** Journal of Machine Learning Research (JMLR), 2012
+**
+** Please check www.github.com/Craigacp/FEAST for updates.
+** 
+** Copyright (c) 2010-2017, A. Pocock, G. Brown, The University of Manchester
+** All rights reserved.
+** 
+** Redistribution and use in source and binary forms, with or without modification,
+** are permitted provided that the following conditions are met:
+** 
+**   - Redistributions of source code must retain the above copyright notice, this 
+**     list of conditions and the following disclaimer.
+**   - Redistributions in binary form must reproduce the above copyright notice, 
+**     this list of conditions and the following disclaimer in the documentation 
+**     and/or other materials provided with the distribution.
+**   - Neither the name of The University of Manchester nor the names of its 
+**     contributors may be used to endorse or promote products derived from this 
+**     software without specific prior written permission.
+** 
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+** ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+** ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+** (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+** LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+** ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+** SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+*******************************************************************************/
+
+
+
+/*pthreads need the POSIX definitions*/
+#define _POSIX_C_SOURCE 200112L
+
+#include "FEAST/FSAlgorithms.h"
+#include "FEAST/FSBatch.h"
+#include "FEAST/FSDataset.h"
+#include "FEAST/WeightedFSAlgorithms.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STRESS_SAMPLES 3000
+#define STRESS_FEATURES 30
+#define STRESS_K 10
+#define STRESS_BETA 0.7
+#define STRESS_GAMMA 0.3
+
+/*each criterion through checkedFeatureSelection() serially and with OpenMP,
+**the eight dataset* functions and the five weighted functions*/
+#define STRESS_CRITERIA (FS_BETAGAMMA + 1)
+#define STRESS_CHECKED_JOBS (2 * STRESS_CRITERIA)
+#define STRESS_DATASET_JOBS 8
+#define STRESS_WEIGHTED_JOBS 5
+#define STRESS_JOBS (STRESS_CHECKED_JOBS + STRESS_DATASET_JOBS + STRESS_WEIGHTED_JOBS)
+
+/*the shared inputs, which every thread only reads*/
+static uint *featureMatrix[STRESS_FEATURES];
+static uint classColumn[STRESS_SAMPLES];
+static double weightVector[STRESS_SAMPLES];
+static FEASTDataset *dataset;
+
+static uint serialFeatures[STRESS_JOBS][STRESS_K];
+static double serialScores[STRESS_JOBS][STRESS_K];
+
+static int stressRounds = 4;
+
+/*******************************************************************************
+** runJob() runs job number job, writing its selected features and scores into
+** outputFeatures and featureScores. Returns 0 if the function succeeded.
+*******************************************************************************/
+static int runJob(int job, uint *outputFeatures, double *featureScores) {
+    FSCriterion criterion;
+    FSOptions options;
+    int condMIFeatures[STRESS_K];
+    int i;
+
+    initialiseFSOptions(&options);
+    criterion.betaParam = STRESS_BETA;
+    criterion.gammaParam = STRESS_GAMMA;
+
+    if (job < STRESS_CHECKED_JOBS) {
+        criterion.criterion = job % STRESS_CRITERIA;
+        options.numThreads = (job < STRESS_CRITERIA) ? 1 : 2;
+        return checkedFeatureSelection(STRESS_K,STRESS_SAMPLES,STRESS_FEATURES,featureMatrix,classColumn,&criterion,outputFeatures,featureScores,&options);
+    }
+
+    job -= STRESS_CHECKED_JOBS;
+    if (job < STRESS_DATASET_JOBS) {
+        switch (job) {
+            case 0: datasetMIM(STRESS_K,dataset,outputFeatures,featureScores,&options); break;
+            case 1: datasetmRMR_D(STRESS_K,dataset,outputFeatures,featureScores,&options); break;
+            case 2: datasetCMIM(STRESS_K,dataset,outputFeatures,featureScores,&options); break;
+            case 3: datasetJMI(STRESS_K,dataset,outputFeatures,featureScores,&options); break;
+            case 4: datasetDISR(STRESS_K,dataset,outputFeatures,featureScores,&options); break;
+            case 5: datasetICAP(STRESS_K,dataset,outputFeatures,featureScores,&options); break;
+            case 6:
+                datasetCondMI(STRESS_K,dataset,condMIFeatures,featureScores,&options);
+                for (i = 0; i < STRESS_K; i++) {
+                    outputFeatures[i] = (uint) condMIFeatures[i];
+                }
+                break;
+            default: datasetBetaGamma(STRESS_K,dataset,outputFeatures,featureScores,STRESS_BETA,STRESS_GAMMA,&options); break;
+        }
+        return 0;
+    }
+
+    job -= STRESS_DATASET_JOBS;
+    switch (job) {
+        case 0: weightedMIM(STRESS_K,STRESS_SAMPLES,STRESS_FEATURES,featureMatrix,classColumn,weightVector,outputFeatures,featureScores); break;
+        case 1: weightedCMIM(STRESS_K,STRESS_SAMPLES,STRESS_FEATURES,featureMatrix,classColumn,weightVector,outputFeatures,featureScores); break;
+        case 2: weightedJMI(STRESS_K,STRESS_SAMPLES,STRESS_FEATURES,featureMatrix,classColumn,weightVector,outputFeatures,featureScores); break;
+        case 3: weightedDISR(STRESS_K,STRESS_SAMPLES,STRESS_FEATURES,featureMatrix,classColumn,weightVector,outputFeatures,featureScores); break;
+        default:
+            weightedCondMI(STRESS_K,STRESS_SAMPLES,STRESS_FEATURES,featureMatrix,classColumn,weightVector,condMIFeatures,featureScores);
+            for (i = 0; i < STRESS_K; i++) {
+                outputFeatures[i] = (uint) condMIFeatures[i];
+            }
+            break;
+    }
+    return 0;
+}/*runJob(int,uint*,double*)*/
+
+/*******************************************************************************
+** stressThread() runs every job stressRounds times, starting at a different
+** job in each thread so different functions overlap, and returns the number
+** of runs which didn't match the serial results.
+*******************************************************************************/
+static void* stressThread(void *arg) {
+    size_t threadNumber = *((size_t *) arg);
+    uint outputFeatures[STRESS_K];
+    double featureScores[STRESS_K];
+    int round, i, job;
+
+    *((size_t *) arg) = 0;
+    for (round = 0; round < stressRounds; round++) {
+        for (i = 0; i < STRESS_JOBS; i++) {
+            job = (int) ((i + threadNumber) % STRESS_JOBS);
+            memset(outputFeatures, 0, sizeof(outputFeatures));
+            memset(featureScores, 0, sizeof(featureScores));
+            if ((runJob(job,outputFeatures,featureScores) != 0)
+                    || memcmp(outputFeatures, serialFeatures[job], sizeof(outputFeatures))
+                    || memcmp(featureScores, serialScores[job], sizeof(featureScores))) {
+                fprintf(stderr, "Thread %lu, job %d differs from the serial run\n", (unsigned long) threadNumber, job);
+                *((size_t *) arg) += 1;
+            }
+        }
+    }
+
+    return NULL;
+}/*stressThread(void*)*/
+
+int main(int argc, char *argv[]) {
+    int numThreads = (argc > 1) ? atoi(argv[1]) : 16;
+    pthread_t *threads;
+    size_t *threadResults;
+    size_t failures = 0;
+    int i, j;
+
+    if (argc > 2) {
+        stressRounds = atoi(argv[2]);
+    }
+    if ((numThreads < 1) || (stressRounds < 1)) {
+        fprintf(stderr, "Usage: FEASTStress [threads] [rounds]\n");
+        return 1;
+    }
+
+    /*features with 2 to 6 states, a class depending on two of them, and
+    **weights which vary by sample*/
+    srand(3);
+    for (j = 0; j < STRESS_FEATURES; j++) {
+        featureMatrix[j] = (uint *) malloc(sizeof(uint) * STRESS_SAMPLES);
+        for (i = 0; i < STRESS_SAMPLES; i++) {
+            featureMatrix[j][i] = rand() % (2 + j % 5);
+        }
+    }
+    for (i = 0; i < STRESS_SAMPLES; i++) {
+        classColumn[i] = (featureMatrix[0][i] + featureMatrix[3][i] + rand() % 2) % 3;
+        weightVector[i] = 0.5 + (rand() % 100) / 100.0;
+    }
+    dataset = createFEASTDataset(STRESS_SAMPLES,STRESS_FEATURES,featureMatrix,classColumn,NULL);
+
+    for (j = 0; j < STRESS_JOBS; j++) {
+        if (runJob(j,serialFeatures[j],serialScores[j]) != 0) {
+            fprintf(stderr, "Serial run of job %d failed\n", j);
+            return 1;
+        }
+    }
+
+    threads = (pthread_t *) malloc(sizeof(pthread_t) * numThreads);
+    threadResults = (size_t *) malloc(sizeof(size_t) * numThreads);
+    for (i = 0; i < numThreads; i++) {
+        threadResults[i] = (size_t) i;
+        if (pthread_create(threads + i, NULL, stressThread, threadResults + i) != 0) {
+            fprintf(stderr, "Failed to start thread %d\n", i);
+            return 1;
+        }
+    }
+    for (i = 0; i < numThreads; i++) {
+        pthread_join(threads[i], NULL);
+        failures += threadResults[i];
+    }
+
+    printf("%d threads ran %d functions %d times each, %lu runs differed from the serial results\n",
+           numThreads, STRESS_JOBS, stressRounds, (unsigned long) failures);
+
+    freeFEASTDataset(dataset);
+    for (j = 0; j < STRESS_FEATURES; j++) {
+        free(featureMatrix[j]);
+    }
+    free(threads);
+    free(threadResults);
+
+    return failures == 0 ? 0 : 1;
+}/*main(int,char**)*/
@@ -9,6 +9,9 @@
 **           12/10/2014 - Added a note saying FEAST expects column-major matrices.
 **           14/09/2016 - Added double and uint entry points for all functions.
 **           18/12/2016 - Added an output variable for the feature scores.
+**           17/10/2026 - Added *WithOptions entry points for multi-threaded scoring.
+**           17/10/2026 - Added dataset* entry points which take a FEASTDataset.
+**           17/10/2026 - Added *WithOptions entry points for the remaining algorithms.
 **
 ** Part of the FEAture Selection Toolbox (FEAST), please reference
 ** "Conditional Likelihood Maximisation: A Unifying Framework for Information
@@ -61,10 +64,21 @@
  * Each algorithm uses a forward search, and selects the feature which has
  * the maxmimum MI with the labels first.
  *
- * All the algorithms except CMIM use an optimised variant which caches the
- * previously calculated MI values. This trades space for time, but can 
- * allocate large amounts of memory. CMIM uses the optimised implementation
- * given in Fleuret (2004). 
+ * The algorithms which sum a term over the selected features keep a running
+ * score for each candidate feature, so each iteration only calculates the
+ * term for the most recently selected feature. This uses memory linear in the
+ * number of features. CMIM uses the optimised implementation given in 
+ * Fleuret (2004). 
+ *
+ * Each algorithm has a *WithOptions variant which takes an FSOptions pointer
+ * (see FSOptions.h) controlling the number of threads used to compute the 
+ * class MI and to score the candidate features. Passing NULL gives the 
+ * defaults.
+ *
+ * Each algorithm also has a dataset* variant which runs on a FEASTDataset
+ * (see FSDataset.h), so a dataset can be normalised once and the class MI
+ * reused across several algorithms. The storage options of a FEASTDataset
+ * are fixed when it is created.
  *
  * Each algorithm returns the outputFeatures pointer.
  *****************************************************************************/
@@ -73,6 +87,8 @@
 #define __FSAlgorithms_H
 
 #include "MIToolbox/MIToolbox.h"
+#include "FEAST/FSOptions.h"
+#include "FEAST/FSDataset.h"
 
 /*******************************************************************************
 ** mRMR_D() implements the minimum Relevance Maximum Redundancy criterion
@@ -82,6 +98,8 @@
 ** H. Peng et al. IEEE Pattern Analysis and Machine Intelligence (PAMI) (2005)
 *******************************************************************************/
 uint* mRMR_D(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores);
+uint* mRMR_DWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores, FSOptions *options);
+uint* datasetmRMR_D(uint k, FEASTDataset *dataset, uint *outputFeatures, double *featureScores, FSOptions *options);
 double* disc_mRMR_D(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *outputFeatures, double *featureScores);
 
 /*******************************************************************************
@@ -93,6 +111,8 @@ double* disc_mRMR_D(uint k, uint noOfSamples, uint noOfFeatures, double **featur
 ** F. Fleuret, JMLR (2004)
 *******************************************************************************/
 uint* CMIM(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores);
+uint* CMIMWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores, FSOptions *options);
+uint* datasetCMIM(uint k, FEASTDataset *dataset, uint *outputFeatures, double *featureScores, FSOptions *options);
 double* discCMIM(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *outputFeatures, double *featureScores);
 
 /*******************************************************************************
@@ -102,6 +122,8 @@ double* discCMIM(uint k, uint noOfSamples, uint noOfFeatures, double **featureMa
 ** H. Yang and J. Moody, NIPS (1999)
 *******************************************************************************/
 uint* JMI(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores);
+uint* JMIWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores, FSOptions *options);
+uint* datasetJMI(uint k, FEASTDataset *dataset, uint *outputFeatures, double *featureScores, FSOptions *options);
 double* discJMI(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *outputFeatures, double *featureScores);
 
 /*******************************************************************************
@@ -112,6 +134,8 @@ double* discJMI(uint k, uint noOfSamples, uint noOfFeatures, double **featureMat
 ** P. Meyer and G. Bontempi, (2006)
 *******************************************************************************/
 uint* DISR(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores);
+uint* DISRWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores, FSOptions *options);
+uint* datasetDISR(uint k, FEASTDataset *dataset, uint *outputFeatures, double *featureScores, FSOptions *options);
 double* discDISR(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *outputFeatures, double *featureScores);
 
 /*******************************************************************************
@@ -121,6 +145,8 @@ double* discDISR(uint k, uint noOfSamples, uint noOfFeatures, double **featureMa
 ** A. Jakulin, PhD Thesis (2005)
 *******************************************************************************/
 uint* ICAP(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores);
+uint* ICAPWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores, FSOptions *options);
+uint* datasetICAP(uint k, FEASTDataset *dataset, uint *outputFeatures, double *featureScores, FSOptions *options);
 double* discICAP(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *outputFeatures, double *featureScores);
 
 /*******************************************************************************
@@ -130,12 +156,16 @@ double* discICAP(uint k, uint noOfSamples, uint noOfFeatures, double **featureMa
 ** signifying there was not enough information to select a feature.
 *******************************************************************************/
 int* CondMI(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, int *outputFeatures, double *featureScores);
+int* CondMIWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, int *outputFeatures, double *featureScores, FSOptions *options);
+int* datasetCondMI(uint k, FEASTDataset *dataset, int *outputFeatures, double *featureScores, FSOptions *options);
 double* discCondMI(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *outputFeatures, double *featureScores);
 
 /*******************************************************************************
 ** MIM() implements the MIM criterion using a greedy forward search
 *******************************************************************************/
 uint* MIM(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores);
+uint* MIMWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores, FSOptions *options);
+uint* datasetMIM(uint k, FEASTDataset *dataset, uint *outputFeatures, double *featureScores, FSOptions *options);
 double* discMIM(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *outputFeatures, double *featureScores);
 
 /*******************************************************************************
@@ -154,6 +184,8 @@ double* discMIM(uint k, uint noOfSamples, uint noOfFeatures, double **featureMat
 ** Journal of Machine Learning Research (JMLR), 2011
 *******************************************************************************/
 uint* BetaGamma(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores, double beta, double gamma);
+uint* BetaGammaWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores, double beta, double gamma, FSOptions *options);
+uint* datasetBetaGamma(uint k, FEASTDataset *dataset, uint *outputFeatures, double *featureScores, double betaParam, double gammaParam, FSOptions *options);
 double* discBetaGamma(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *outputFeatures, double *featureScores, double beta, double gamma);
 
 #endif
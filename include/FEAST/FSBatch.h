@@ -0,0 +1,148 @@
+/*******************************************************************************
+** FSBatch.h
+** Provides a batch entry point which runs several criteria over the same
+** FEASTDataset in one call, sharing the class MI and a cache of the pairwise
+** terms between them, and betaGammaSweep for evaluating a grid of BetaGamma
+** parameters from one set of raw MI and CMI terms.
+**
+** Author: Adam Pocock
+** Created: 17/10/2026
+**
+** Part of the FEAture Selection Toolbox (FEAST), please reference
+** "Conditional Likelihood Maximisation: A Unifying Framework for Information
+** Theoretic Feature Selection"
+** G. Brown, A. Pocock, M.-J. Zhao, M. Lujan
+** Journal of Machine Learning Research (JMLR), 2012
+**
+** Please check www.github.com/Craigacp/FEAST for updates.
+** 
+** Copyright (c) 2010-2017, A. Pocock, G. Brown, The University of Manchester
+** All rights reserved.
+** 
+** Redistribution and use in source and binary forms, with or without modification,
+** are permitted provided that the following conditions are met:
+** 
+**   - Redistributions of source code must retain the above copyright notice, this 
+**     list of conditions and the following disclaimer.
+**   - Redistributions in binary form must reproduce the above copyright notice, 
+**     this list of conditions and the following disclaimer in the documentation 
+**     and/or other materials provided with the distribution.
+**   - Neither the name of The University of Manchester nor the names of its 
+**     contributors may be used to endorse or promote products derived from this 
+**     software without specific prior written permission.
+** 
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+** ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+** ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+** (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+** LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+** ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+** SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+*******************************************************************************/
+
+
+#ifndef __FSBatch_H
+#define __FSBatch_H
+
+#include "MIToolbox/MIToolbox.h"
+#include "FEAST/FSOptions.h"
+#include "FEAST/FSDataset.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*the criteria which can be run in a batch*/
+#define FS_MIM 0
+#define FS_MRMR_D 1
+#define FS_CMIM 2
+#define FS_JMI 3
+#define FS_DISR 4
+#define FS_ICAP 5
+#define FS_CONDMI 6
+#define FS_BETAGAMMA 7
+
+/*******************************************************************************
+** FSCriterion names one criterion in a batch. betaParam and gammaParam are
+** only used by FS_BETAGAMMA, so MIFS, CIFE and CondRed are each a
+** FS_BETAGAMMA entry with the appropriate parameters.
+*******************************************************************************/
+typedef struct FSCriterion {
+    int criterion;
+    double betaParam;
+    double gammaParam;
+} FSCriterion;
+
+/*the error codes returned by checkedFeatureSelection() and workspaceFeatureSelection()*/
+#define FS_OK 0
+#define FS_ERROR_ARGUMENT -1
+#define FS_ERROR_STATES -2
+#define FS_ERROR_WORKSPACE -3
+#define FS_ERROR_MEMORY -4
+
+/*******************************************************************************
+** checkedFeatureSelection() selects k features from a uint dataset with one
+** criterion, checking the arguments first. It returns FS_OK, or without
+** selecting anything FS_ERROR_ARGUMENT if a pointer is NULL, the criterion is
+** unknown, there are no samples or k is more than noOfFeatures, and
+** FS_ERROR_STATES if a value is INT_MAX or more, or the contingency tables
+** wouldn't fit in an int. The pairwise tables have a cell for every
+** combination of two features' states, so the two features with the most
+** states must have at most INT_MAX combinations, and CondMI's condition may
+** have as many states as there are samples. A huge value usually means a
+** negative value was cast to a uint, and the unchecked functions would try to
+** allocate tables with billions of cells. It returns FS_ERROR_MEMORY, again
+** without selecting anything, if the memory for the columns or the search
+** can't be allocated, as all of it is allocated before the first feature is
+** selected. Positions CondMI cannot fill are set to (uint) -1.
+**
+** Every FEAST function keeps its state in its own allocations, and none of
+** them write to the feature matrix, the class column or a FEASTDataset, so
+** any number of threads can run them at once on shared data, each with its
+** own output arrays. FEASTSearch and FEASTSelector objects must only be used
+** by one thread at a time, and the shards in FSShards.h should be created
+** before other threads are started, as they fork the process.
+*******************************************************************************/
+int checkedFeatureSelection(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, FSCriterion *criterion, uint *outputFeatures, double *featureScores, FSOptions *options);
+
+/*******************************************************************************
+** batchFeatureSelection() selects k features with each of the noOfCriteria
+** criteria, writing the ranking and scores of criteria[i] into
+** outputFeatures[i] and featureScores[i], each of length k.
+**
+** The class MI is calculated once, and the MI, conditional MI and joint
+** terms between each selected feature and every other feature are calculated
+** once and cached, so features chosen by several criteria are only scored
+** once. Only the terms the criteria read are kept: mRMR_D, CMIM and JMI
+** each need one, DISR two, and ICAP and BetaGamma share the MI and CMI.
+** mRMR_D keeps its I(X_m;X_j) apart, calculated as mRMR_D() does. The
+** cache costs noOfFeatures doubles per term for each distinct selected
+** feature, so at most 6 * k * noOfFeatures doubles with every criterion,
+** and k * noOfFeatures for a single criterion which needs one term. CondMI conditions on the joint state of all the selected
+** features, so it only shares the class MI. Positions CondMI cannot fill are
+** set to (uint) -1, as in CondMI().
+*******************************************************************************/
+void batchFeatureSelection(uint k, FEASTDataset *dataset, uint noOfCriteria, FSCriterion *criteria, uint **outputFeatures, double **featureScores, FSOptions *options);
+
+/*******************************************************************************
+** betaGammaSweep() runs BetaGamma once for each of the noOfPairs parameter
+** pairs (betaParams[i], gammaParams[i]), writing the ranking and scores into
+** outputFeatures[i] and featureScores[i], each of length k.
+**
+** The raw I(X_m;X_j) and I(X_m;X_j|Y) terms are cached separately, so each
+** grid point only combines them with its own parameters and the whole grid
+** costs roughly one BetaGamma run for the features the points share.
+** BetaGammaSweep() builds a temporary FEASTDataset from the feature matrix.
+*******************************************************************************/
+void betaGammaSweep(uint k, FEASTDataset *dataset, uint noOfPairs, double *betaParams, double *gammaParams, uint **outputFeatures, double **featureScores, FSOptions *options);
+void BetaGammaSweep(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint noOfPairs, double *betaParams, double *gammaParams, uint **outputFeatures, double **featureScores, FSOptions *options);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,117 @@
+/*******************************************************************************
+** FSDataset.h
+** Provides FEASTDataset, a handle to a dataset which has been normalised and
+** preprocessed once, so it can be passed to several algorithms without
+** repeating the conversion. The dataset* variants of each algorithm are in
+** FSAlgorithms.h.
+**
+** Author: Adam Pocock
+** Created: 17/10/2026
+**
+** Part of the FEAture Selection Toolbox (FEAST), please reference
+** "Conditional Likelihood Maximisation: A Unifying Framework for Information
+** Theoretic Feature Selection"
+** G. Brown, A. Pocock, M.-J. Zhao, M. Lujan
+** Journal of Machine Learning Research (JMLR), 2012
+**
+** Please check www.github.com/Craigacp/FEAST for updates.
+** 
+** Copyright (c) 2010-2017, A. Pocock, G. Brown, The University of Manchester
+** All rights reserved.
+** 
+** Redistribution and use in source and binary forms, with or without modification,
+** are permitted provided that the following conditions are met:
+** 
+**   - Redistributions of source code must retain the above copyright notice, this 
+**     list of conditions and the following disclaimer.
+**   - Redistributions in binary form must reproduce the above copyright notice, 
+**     this list of conditions and the following disclaimer in the documentation 
+**     and/or other materials provided with the distribution.
+**   - Neither the name of The University of Manchester nor the names of its 
+**     contributors may be used to endorse or promote products derived from this 
+**     software without specific prior written permission.
+** 
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+** ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+** ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+** (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+** LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+** ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+** SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+*******************************************************************************/
+
+
+#ifndef __FSDataset_H
+#define __FSDataset_H
+
+#include "MIToolbox/MIToolbox.h"
+#include "FEAST/FSOptions.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+** FEASTDataset is an opaque handle to a preprocessed dataset. It holds its
+** own copy of every column at the narrowest width which fits, along with the
+** number of states and entropy of each column and the MI of each feature
+** with the class. The dataset isn't modified by the algorithms, so one
+** dataset can be used by several algorithms at the same time.
+*******************************************************************************/
+typedef struct FEASTDataset FEASTDataset;
+
+/*******************************************************************************
+** createFEASTDataset() builds a dataset from discrete uint columns, and
+** discFEASTDataset() builds one from double columns, normalising them as the
+** disc* functions do. The caller's arrays can be freed once it returns.
+**
+** options->numThreads controls the threads used for the relevance pass,
+** options->bitmapIndex builds the bitmap index, options->deduplicateRows
+** collapses the duplicate rows, and options->removeRedundantFeatures leaves
+** the constant and duplicate features out of the search. The other options
+** are ignored. options may be NULL.
+**
+** The dataset must be freed with freeFEASTDataset().
+*******************************************************************************/
+FEASTDataset* createFEASTDataset(uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, FSOptions *options);
+FEASTDataset* discFEASTDataset(uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, FSOptions *options);
+void freeFEASTDataset(FEASTDataset *dataset);
+
+/*******************************************************************************
+** sparseFEASTDataset() builds a dataset from discrete features in compressed
+** sparse column form. The entries of feature i are positions
+** columnStarts[i] to columnStarts[i+1]-1 of rowIndices and values, with the
+** row indices of each feature strictly increasing. Every sample not listed
+** is zero. classColumn is dense. options->deduplicateRows is ignored.
+**
+** The pairwise terms between two sparse features are counted from the rows
+** stored in either of them, so their cost scales with the number of nonzeros
+** rather than noOfSamples, and they give the same values as a dense dataset.
+*******************************************************************************/
+FEASTDataset* sparseFEASTDataset(uint noOfSamples, uint noOfFeatures, uint *columnStarts, uint *rowIndices, uint *values, uint *classColumn, FSOptions *options);
+
+/*******************************************************************************
+** Accessors for the dimensions of the dataset, and the cached per feature
+** values. These always use the original feature indices.
+** datasetNumStates() is one more than the largest value of the (normalised)
+** feature. datasetNoOfRows() is the number of distinct rows
+** stored when the duplicate rows have been collapsed, otherwise it is the
+** number of samples.
+*******************************************************************************/
+uint datasetNoOfSamples(FEASTDataset *dataset);
+uint datasetNoOfRows(FEASTDataset *dataset);
+uint datasetNoOfFeatures(FEASTDataset *dataset);
+int datasetNumStates(FEASTDataset *dataset, uint feature);
+double datasetEntropy(FEASTDataset *dataset, uint feature);
+double datasetClassEntropy(FEASTDataset *dataset);
+double datasetClassMI(FEASTDataset *dataset, uint feature);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
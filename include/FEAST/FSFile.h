@@ -0,0 +1,139 @@
+/*******************************************************************************
+** FSFile.h
+** Provides the FEAST column file format, a binary file holding a discrete
+** dataset one column at a time, a writer which builds one a column at a time,
+** a reader which loads one into uint columns, and mapFEASTDataset which runs
+** the algorithms on a file without reading it into memory.
+**
+** Author: Adam Pocock
+** Created: 17/10/2026
+**
+** Part of the FEAture Selection Toolbox (FEAST), please reference
+** "Conditional Likelihood Maximisation: A Unifying Framework for Information
+** Theoretic Feature Selection"
+** G. Brown, A. Pocock, M.-J. Zhao, M. Lujan
+** Journal of Machine Learning Research (JMLR), 2012
+**
+** Please check www.github.com/Craigacp/FEAST for updates.
+** 
+** Copyright (c) 2010-2017, A. Pocock, G. Brown, The University of Manchester
+** All rights reserved.
+** 
+** Redistribution and use in source and binary forms, with or without modification,
+** are permitted provided that the following conditions are met:
+** 
+**   - Redistributions of source code must retain the above copyright notice, this 
+**     list of conditions and the following disclaimer.
+**   - Redistributions in binary form must reproduce the above copyright notice, 
+**     this list of conditions and the following disclaimer in the documentation 
+**     and/or other materials provided with the distribution.
+**   - Neither the name of The University of Manchester nor the names of its 
+**     contributors may be used to endorse or promote products derived from this 
+**     software without specific prior written permission.
+** 
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+** ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+** ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+** (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+** LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+** ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+** SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+*******************************************************************************/
+
+
+#ifndef __FSFile_H
+#define __FSFile_H
+
+#include "MIToolbox/MIToolbox.h"
+#include "FEAST/FSOptions.h"
+#include "FEAST/FSDataset.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+** A FEAST column file holds a discrete dataset in the machine's byte order.
+** The header is the 8 characters "FEASTCOL" followed by the uints
+**
+**   version, noOfSamples, noOfFeatures, alignment,
+**   then width and numStates for each feature and finally the class.
+**
+** width is the bytes per sample (1, 2 or 4) and numStates is one more than
+** the largest value in the column. A file whose numStates is zero, more than
+** the width can hold or INT_MAX, or not more than every value in its
+** column, isn't a valid column file. The columns follow in the same order,
+** each starting at a multiple of alignment bytes from the start of the file
+** and holding noOfSamples values of width bytes, so the features are laid
+** out in index order and the class comes last.
+*******************************************************************************/
+#define FEAST_FILE_VERSION 1
+#define FEAST_FILE_ALIGNMENT 4096
+
+/*******************************************************************************
+** FEASTFileWriter writes a column file one column at a time, so the dataset
+** never has to be held in memory.
+**
+** createFEASTFile() opens fileName for writing, and returns NULL if it can't.
+** appendFEASTColumn() writes the next column, each feature in index order and
+** then the class, each holding noOfSamples values. closeFEASTFile() writes
+** the header and closes the file, freeing the writer. Both return 0 on
+** success and -1 if a write failed or the wrong number of columns was
+** appended, in which case the file is incomplete.
+**
+** writeFEASTFile() writes a whole in memory dataset.
+*******************************************************************************/
+typedef struct FEASTFileWriter FEASTFileWriter;
+
+FEASTFileWriter* createFEASTFile(const char *fileName, uint noOfSamples, uint noOfFeatures);
+int appendFEASTColumn(FEASTFileWriter *writer, uint *column);
+int closeFEASTFile(FEASTFileWriter *writer);
+int writeFEASTFile(const char *fileName, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn);
+
+/*******************************************************************************
+** FEASTColumns is a dataset read from a column file, with the columns
+** widened to uints so they can be passed straight to the algorithms, e.g.
+**
+**   JMI(k, columns->noOfSamples, columns->noOfFeatures,
+**       columns->featureMatrix, columns->classColumn, outputs, scores);
+**
+** readFEASTFile() reads a column file, returning NULL if the file can't be
+** read or isn't a valid column file. The columns are copied in a block at a
+** time with no parsing. The result must be freed with freeFEASTColumns().
+*******************************************************************************/
+typedef struct FEASTColumns {
+    uint noOfSamples;
+    uint noOfFeatures;
+    uint **featureMatrix;
+    uint *classColumn;
+} FEASTColumns;
+
+FEASTColumns* readFEASTFile(const char *fileName);
+void freeFEASTColumns(FEASTColumns *columns);
+
+/*******************************************************************************
+** mapFEASTDataset() builds a FEASTDataset whose columns are read straight from
+** a memory mapping of a column file, so the operating system pages them in as
+** the algorithms need them and the dataset can be larger than memory. The
+** feature columns are marked for sequential access and the class column as
+** needed soon. Each round of a forward search scores the candidates in index
+** order, which is the order they are laid out in the file, so it reads the
+** file front to back.
+**
+** The options are used as in createFEASTDataset(), though
+** options->deduplicateRows and options->bitmapIndex build in memory copies.
+** Returns NULL if the file can't be opened or isn't a valid column file.
+** Where memory mapping isn't available the file is read into memory instead.
+** The dataset must be freed with freeFEASTDataset(), which unmaps the file.
+*******************************************************************************/
+FEASTDataset* mapFEASTDataset(const char *fileName, FSOptions *options);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
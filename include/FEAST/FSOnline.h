@@ -0,0 +1,105 @@
+/*******************************************************************************
+** FSOnline.h
+** Provides FEASTSelector, an online feature selector which keeps the count
+** tables behind the pairwise criteria and updates them as samples arrive.
+**
+** Author: Adam Pocock
+** Created: 17/10/2026
+**
+** Part of the FEAture Selection Toolbox (FEAST), please reference
+** "Conditional Likelihood Maximisation: A Unifying Framework for Information
+** Theoretic Feature Selection"
+** G. Brown, A. Pocock, M.-J. Zhao, M. Lujan
+** Journal of Machine Learning Research (JMLR), 2012
+**
+** Please check www.github.com/Craigacp/FEAST for updates.
+** 
+** Copyright (c) 2010-2017, A. Pocock, G. Brown, The University of Manchester
+** All rights reserved.
+** 
+** Redistribution and use in source and binary forms, with or without modification,
+** are permitted provided that the following conditions are met:
+** 
+**   - Redistributions of source code must retain the above copyright notice, this 
+**     list of conditions and the following disclaimer.
+**   - Redistributions in binary form must reproduce the above copyright notice, 
+**     this list of conditions and the following disclaimer in the documentation 
+**     and/or other materials provided with the distribution.
+**   - Neither the name of The University of Manchester nor the names of its 
+**     contributors may be used to endorse or promote products derived from this 
+**     software without specific prior written permission.
+** 
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+** ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+** ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+** (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+** LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+** ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+** SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+*******************************************************************************/
+
+
+#ifndef __FSOnline_H
+#define __FSOnline_H
+
+#include "MIToolbox/MIToolbox.h"
+#include "FEAST/FSBatch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+** FEASTSelector holds the (feature,class) count table of every feature and
+** the (feature,feature,class) count table of every pair of features. Every
+** term the pairwise criteria use is a function of one of these tables, so a
+** ranking can be recalculated at any time without another pass over the
+** samples.
+**
+** createFEASTSelector() makes an empty selector for noOfFeatures features,
+** where feature i takes values in [0,numStates[i]) and the class takes values
+** in [0,classNumStates). The tables are allocated up front, one cell for each
+** combination of states, so the memory grows with the square of the number
+** of features. If windowSize is non-zero only the most recent windowSize
+** samples are counted, and the selector keeps a copy of them so the oldest
+** can be removed as new ones arrive, which lets the selection follow drift in
+** the data.
+**
+** addFEASTSamples() counts noOfSamples new samples, given as noOfFeatures
+** columns in featureMatrix and the class in classColumn. The cost is linear
+** in noOfSamples and independent of the samples already seen. Returns 0, or
+** -1 without changing the selector if a value is outside its declared
+** states or the samples counted would pass INT_MAX.
+**
+** selectorNoOfSamples() returns the number of samples currently counted.
+**
+** selectorSearch() selects k features with one criterion from FSBatch.h,
+** writing them into outputFeatures and their scores into featureScores. Only
+** the tables of the selected features are read, so a search costs
+** O(k * noOfFeatures) table scans. FS_CONDMI conditions on all the selected
+** features at once, which the pairwise tables can't answer, so it returns
+** NULL, as it does if no samples have been counted.
+**
+** The class MI matches the batch algorithms exactly. The other terms sum the
+** cells of each table in index order rather than in the order the pairs were
+** first seen, so they can differ from the batch algorithms in the last bits.
+**
+** freeFEASTSelector() frees the selector.
+*******************************************************************************/
+typedef struct FEASTSelector FEASTSelector;
+
+FEASTSelector* createFEASTSelector(uint noOfFeatures, uint *numStates, uint classNumStates, uint windowSize);
+int addFEASTSamples(FEASTSelector *selector, uint noOfSamples, uint **featureMatrix, uint *classColumn);
+uint selectorNoOfSamples(FEASTSelector *selector);
+uint* selectorSearch(uint k, FEASTSelector *selector, FSCriterion *criterion, uint *outputFeatures, double *featureScores);
+void freeFEASTSelector(FEASTSelector *selector);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,129 @@
+/*******************************************************************************
+** FSOptions.h
+** Provides the options struct which controls the optional behaviour of the
+** FEAST algorithms, such as the number of threads used to score the candidate
+** features. Pass NULL to any of the *WithOptions functions to get the defaults.
+**
+** Author: Adam Pocock
+** Created: 17/10/2026
+**
+** Part of the FEAture Selection Toolbox (FEAST), please reference
+** "Conditional Likelihood Maximisation: A Unifying Framework for Information
+** Theoretic Feature Selection"
+** G. Brown, A. Pocock, M.-J. Zhao, M. Lujan
+** Journal of Machine Learning Research (JMLR), 2012
+**
+** Please check www.github.com/Craigacp/FEAST for updates.
+** 
+** Copyright (c) 2010-2017, A. Pocock, G. Brown, The University of Manchester
+** All rights reserved.
+** 
+** Redistribution and use in source and binary forms, with or without modification,
+** are permitted provided that the following conditions are met:
+** 
+**   - Redistributions of source code must retain the above copyright notice, this 
+**     list of conditions and the following disclaimer.
+**   - Redistributions in binary form must reproduce the above copyright notice, 
+**     this list of conditions and the following disclaimer in the documentation 
+**     and/or other materials provided with the distribution.
+**   - Neither the name of The University of Manchester nor the names of its 
+**     contributors may be used to endorse or promote products derived from this 
+**     software without specific prior written permission.
+** 
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+** ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+** ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+** (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+** LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+** ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+** SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+*******************************************************************************/
+
+
+#ifndef __FSOptions_H
+#define __FSOptions_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+** FSOptions holds the optional settings for a FEAST algorithm.
+**
+** numThreads - the number of threads used to score the candidate features in
+**              each iteration. 1 runs serially (the default), 0 uses all the
+**              available cores. The selected features and scores are identical
+**              for any number of threads. Ignored if FEAST is compiled without
+**              OpenMP support.
+**
+** compactStorage - if non-zero the features and class are copied into 8 or 16
+**              bit columns where their number of states allows before the
+**              search starts, reducing the memory traffic of each MI
+**              calculation. Off by default as it needs memory for the copies.
+**              The disc* functions and FEASTDatasets always store their
+**              columns this way.
+**
+** bitmapIndex - if non-zero a bitset is built for each state of every column
+**              with at most 16 states, and the joint counts of small tables
+**              are found by ANDing bitsets and counting bits rather than by
+**              visiting each sample. Most useful for binary features with
+**              many samples. Used by CMIM, JMI, CondMI, DISR, ICAP and
+**              BetaGamma. Off by default.
+**
+** lazyEvaluation - if non-zero the pairwise terms are only calculated for
+**              candidates whose upper bound can still beat the best score
+**              found so far in that iteration, visiting the candidates in
+**              descending order of class MI. The missing terms are added if
+**              the candidate later becomes competitive, so the selected
+**              features and scores are unchanged. Used by ICAP, mRMR_D and
+**              BetaGamma when betaParam >= 0 and gammaParam <= 0. JMI and
+**              DISR instead queue the candidates in a max-heap keyed by an
+**              upper bound built from H(Y) and H(X_j), which is tight for low
+**              entropy features such as sparse binary ones, and score them
+**              serially. checkedFeatureSelection() ignores it, as it runs
+**              the rounds of FEASTSearch. Off by default.
+**
+** deduplicateRows - if non-zero the samples are hashed and identical rows
+**              (every feature and the class) are collapsed into one row
+**              which counts for all of them. Each count table then visits
+**              only the distinct rows, and every MI value is the same as on
+**              the full data. Useful for discretised data with many repeated
+**              rows. It takes a copy of the distinct rows, and disables
+**              bitmapIndex if any rows were collapsed. Off by default.
+**
+**              checkedFeatureSelection() skips the row deduplication and the
+**              bitmap index if their memory can't be allocated, as the
+**              results are the same without them.
+**
+** removeRedundantFeatures - if non-zero a FEASTDataset leaves the constant
+**              features, and every feature identical to an earlier one, out
+**              of the search. The columns are fingerprinted by a hash and
+**              checked sample by sample. The selected features are returned
+**              with their original indices. This changes the selections of
+**              criteria such as MIM and JMI, which would otherwise pick a copy
+**              of a selected feature. Only used when building a FEASTDataset.
+**              Off by default.
+*******************************************************************************/
+typedef struct FSOptions {
+    int numThreads;
+    int compactStorage;
+    int bitmapIndex;
+    int lazyEvaluation;
+    int deduplicateRows;
+    int removeRedundantFeatures;
+} FSOptions;
+
+/*******************************************************************************
+** initialiseFSOptions() sets all the options to their default values.
+*******************************************************************************/
+void initialiseFSOptions(FSOptions *options);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,176 @@
+/*******************************************************************************
+** FSSearch.h
+** Provides FEASTSearch, the state of a forward search which can be extended
+** to more features and saved to a file between sessions.
+**
+** Author: Adam Pocock
+** Created: 17/10/2026
+**
+** Part of the FEAture Selection Toolbox (FEAST), please reference
+** "Conditional Likelihood Maximisation: A Unifying Framework for Information
+** Theoretic Feature Selection"
+** G. Brown, A. Pocock, M.-J. Zhao, M. Lujan
+** Journal of Machine Learning Research (JMLR), 2012
+**
+** Please check www.github.com/Craigacp/FEAST for updates.
+** 
+** Copyright (c) 2010-2017, A. Pocock, G. Brown, The University of Manchester
+** All rights reserved.
+** 
+** Redistribution and use in source and binary forms, with or without modification,
+** are permitted provided that the following conditions are met:
+** 
+**   - Redistributions of source code must retain the above copyright notice, this 
+**     list of conditions and the following disclaimer.
+**   - Redistributions in binary form must reproduce the above copyright notice, 
+**     this list of conditions and the following disclaimer in the documentation 
+**     and/or other materials provided with the distribution.
+**   - Neither the name of The University of Manchester nor the names of its 
+**     contributors may be used to endorse or promote products derived from this 
+**     software without specific prior written permission.
+** 
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+** ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+** ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+** (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+** LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+** ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+** SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+*******************************************************************************/
+
+
+
+#ifndef __FSSearch_H
+#define __FSSearch_H
+
+#include <stddef.h>
+
+#include "MIToolbox/MIToolbox.h"
+#include "FEAST/FSOptions.h"
+#include "FEAST/FSDataset.h"
+#include "FEAST/FSBatch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+** FEASTSearch holds everything a forward search carries from one round to
+** the next: the class MI of every feature, the features selected so far and
+** their scores, the running score of each candidate, CMIM's partial scores
+** and the number of selected features each one has been checked against,
+** and CondMI's condition vector. Extending a search to more features only
+** runs the extra rounds.
+**
+** startFEASTSearch() starts a search of dataset with one criterion from
+** FSBatch.h, calculating the class MI. options->numThreads is used as in
+** the dataset* algorithms and the other options are ignored. options may be
+** NULL.
+**
+** continueFEASTSearch() runs rounds until k features are selected, or every
+** feature has been, then writes the first k into outputFeatures and their
+** scores into featureScores, exactly as datasetJMI() and the other dataset*
+** functions would. For FS_CONDMI positions which can't be filled are set to
+** (uint) -1, as in batchFeatureSelection(). k may be smaller than a previous
+** call, in which case nothing is calculated. The dataset must be the one the
+** search was started on. Returns FS_SEARCH_COMPLETE, or FS_SEARCH_TIMED_OUT or
+** FS_SEARCH_CANCELLED if the limits from setSearchLimits() stopped it early, in
+** which case only the first searchNoOfSelected() positions are written. Returns
+** FS_SEARCH_WRONG_DATASET without running any rounds if the dataset doesn't
+** match the search's fingerprint, or FS_SEARCH_CHECKPOINT_FAILED if a
+** checkpoint couldn't be written.
+**
+** searchNoOfSelected() returns the number of rounds run so far.
+**
+** freeFEASTSearch() frees the search.
+*******************************************************************************/
+typedef struct FEASTSearch FEASTSearch;
+
+/*the results of continueFEASTSearch()*/
+#define FS_SEARCH_COMPLETE 0
+#define FS_SEARCH_TIMED_OUT 1
+#define FS_SEARCH_CANCELLED 2
+#define FS_SEARCH_WRONG_DATASET -1
+#define FS_SEARCH_CHECKPOINT_FAILED -2
+
+FEASTSearch* startFEASTSearch(FEASTDataset *dataset, FSCriterion *criterion, FSOptions *options);
+int continueFEASTSearch(uint k, FEASTSearch *search, FEASTDataset *dataset, uint *outputFeatures, double *featureScores, FSOptions *options);
+uint searchNoOfSelected(FEASTSearch *search);
+void freeFEASTSearch(FEASTSearch *search);
+
+/*******************************************************************************
+** saveFEASTSearch() writes the search to fileName, and loadFEASTSearch() reads
+** it back, so a search can be extended in a later session once its dataset is
+** rebuilt with the same options. The file is in the machine's byte order, and
+** holds a fingerprint of the searched columns. The search is written to
+** fileName.tmp, flushed to disk and renamed over fileName, so an interrupted
+** save leaves the previous file intact. On POSIX systems the directory is then
+** synced so the rename survives a crash, and on Windows MoveFileEx() replaces
+** the old file. saveFEASTSearch() returns 0 on success and -1 if the file can't
+** be written. loadFEASTSearch() returns NULL if the file can't be read or isn't
+** a saved search, checking its length against the sizes in its header before
+** allocating anything, and the selected features and CondMI's condition against
+** the search.
+*******************************************************************************/
+int saveFEASTSearch(FEASTSearch *search, const char *fileName);
+FEASTSearch* loadFEASTSearch(const char *fileName);
+
+/*******************************************************************************
+** setSearchLimits() makes each continueFEASTSearch() call stop once it has
+** run for timeLimit seconds, or when progress returns non-zero. progress is
+** called after each round with progressData, the number of features
+** selected so far and their indices and scores, which are only valid during
+** the call. Whichever stops the search, the round in progress is finished
+** first, so the prefix is exactly what a complete search would return, and
+** a later call carries on from it. A zero timeLimit or a NULL progress turns
+** that limit off. The time is measured on a monotonic clock where one is
+** available, otherwise to the nearest second.
+*******************************************************************************/
+typedef int (*FSProgressFunction)(void *progressData, uint noOfSelected, uint *outputFeatures, double *featureScores);
+
+void setSearchLimits(FEASTSearch *search, double timeLimit, FSProgressFunction progress, void *progressData);
+
+/*******************************************************************************
+** setSearchCheckpoint() makes continueFEASTSearch() save the search to
+** fileName after every everyRounds rounds, or after the first round which
+** ends everySeconds or more after the last save, whichever comes first, and
+** again when it returns. A zero disables that trigger, and a NULL fileName
+** turns checkpointing off. The setting isn't saved with the search.
+**
+** resumeFEASTSearch() loads a saved search or checkpoint and checks it
+** against dataset, hashing every column of the dataset once. Returns NULL if
+** the file can't be loaded or was written for a different dataset, or for
+** the same data built with different options. A search from
+** loadFEASTSearch() is checked on its first continueFEASTSearch() instead.
+*******************************************************************************/
+void setSearchCheckpoint(FEASTSearch *search, const char *fileName, uint everyRounds, double everySeconds);
+FEASTSearch* resumeFEASTSearch(const char *fileName, FEASTDataset *dataset, FSOptions *options);
+
+/*******************************************************************************
+** workspaceFeatureSelection() runs a whole search over a uint dataset, like
+** checkedFeatureSelection() on one thread, without allocating any memory. The
+** columns are read in place, and the search state and the counting tables
+** are carved from workspace, which the caller allocates once and can reuse
+** for every call on data of the same size. searchWorkspaceSize() returns the
+** bytes needed when every feature value is less than numStates and every
+** class value less than classNumStates. The workspace must be aligned as
+** malloc() aligns it. Each call leaves its counting tables zeroed for the
+** next, and records this at the start of the workspace, so they are only
+** cleared again when the sizes change or the record is missing, as it is in
+** a new workspace that wasn't zeroed. The workspace must not be modified
+** between calls. It can only be used by one call at a time. Returns
+** the codes of checkedFeatureSelection(), or FS_ERROR_WORKSPACE if the data
+** needs a larger workspace than workspaceSize.
+*******************************************************************************/
+size_t searchWorkspaceSize(FSCriterion *criterion, uint noOfSamples, uint noOfFeatures, uint numStates, uint classNumStates);
+int workspaceFeatureSelection(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, FSCriterion *criterion, uint *outputFeatures, double *featureScores, void *workspace, size_t workspaceSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,129 @@
+/*******************************************************************************
+** FSShards.h
+** Provides sharded feature selection, where worker processes each own a
+** slice of the rows or of the features and a coordinator combines their
+** results.
+**
+** Author: Adam Pocock
+** Created: 17/10/2026
+**
+** Part of the FEAture Selection Toolbox (FEAST), please reference
+** "Conditional Likelihood Maximisation: A Unifying Framework for Information
+** Theoretic Feature Selection"
+** G. Brown, A. Pocock, M.-J. Zhao, M. Lujan
+** Journal of Machine Learning Research (JMLR), 2012
+**
+** Please check www.github.com/Craigacp/FEAST for updates.
+** 
+** Copyright (c) 2010-2017, A. Pocock, G. Brown, The University of Manchester
+** All rights reserved.
+** 
+** Redistribution and use in source and binary forms, with or without modification,
+** are permitted provided that the following conditions are met:
+** 
+**   - Redistributions of source code must retain the above copyright notice, this 
+**     list of conditions and the following disclaimer.
+**   - Redistributions in binary form must reproduce the above copyright notice, 
+**     this list of conditions and the following disclaimer in the documentation 
+**     and/or other materials provided with the distribution.
+**   - Neither the name of The University of Manchester nor the names of its 
+**     contributors may be used to endorse or promote products derived from this 
+**     software without specific prior written permission.
+** 
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+** ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+** ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+** (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+** LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+** ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+** SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+*******************************************************************************/
+
+
+#ifndef __FSShards_H
+#define __FSShards_H
+
+#include "MIToolbox/MIToolbox.h"
+#include "FEAST/FSBatch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+** FEASTShards is a dataset split by rows across noOfShards worker processes.
+** Worker s owns a contiguous block of the rows, and the blocks are in row
+** order. The coordinator, the calling process, doesn't count any rows itself.
+** Every information theoretic term is a function of a contingency table, and
+** the table of the full dataset is the sum of the tables of the blocks, so
+** the workers count their rows and the coordinator adds up the counts and
+** calculates the terms.
+**
+** The coordinator talks to each worker over a Unix socket pair. A worker is
+** forked when the shards are created, and exits when they are freed. Workers
+** count their rows on one thread each, so one shard per core keeps every core
+** busy. The pairs of feature states are merged in the order they first appear
+** in the rows, so the terms, and hence the rankings and scores, are identical
+** to JMI() and CMIM() run over the whole dataset in one process.
+**
+** shardFEASTFile() shards a column file (see FSFile.h). The file is memory
+** mapped, and each worker only reads the pages holding its own rows.
+** shardFEASTData() shards an in memory dataset, which the workers share with
+** the coordinator copy on write and again only read their own rows. The
+** coordinator reads each column once to find its number of states.
+** noOfShards is clamped to [1,noOfSamples]. Both return NULL if the file isn't
+** a valid column file or a worker can't be started, and sharding is not
+** available on Windows, where they always return NULL.
+**
+** freeFEASTShards() stops the workers and frees the shards. featureMatrix and
+** classColumn must stay valid until then.
+*******************************************************************************/
+typedef struct FEASTShards FEASTShards;
+
+FEASTShards* shardFEASTFile(const char *fileName, uint noOfShards);
+FEASTShards* shardFEASTData(uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint noOfShards);
+void freeFEASTShards(FEASTShards *shards);
+
+/*******************************************************************************
+** featureShardFEASTFile() and featureShardFEASTData() split a dataset by
+** features instead, so worker s owns a contiguous block of the feature
+** columns and keeps the running score of each of them. Every worker reads the
+** class. Each round the coordinator fetches the newly selected column from
+** the worker which owns it and sends it to every worker, which scores its own
+** candidates against it and replies with its best candidate. The coordinator
+** keeps the best of those, so it only ever holds one column, and each worker
+** reads its own columns, the class and the selected column. The rankings and
+** scores are identical to the non-lazy column algorithms. noOfShards is
+** clamped to [1,noOfFeatures], and the shards are freed with
+** freeFEASTShards().
+*******************************************************************************/
+FEASTShards* featureShardFEASTFile(const char *fileName, uint noOfShards);
+FEASTShards* featureShardFEASTData(uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint noOfShards);
+
+/*******************************************************************************
+** shardedSearch() selects k features with one criterion from FSBatch.h,
+** writing them into outputFeatures and their scores into featureScores.
+** Feature shards run any criterion, with betaParam and gammaParam used by
+** FS_BETAGAMMA. Positions FS_CONDMI cannot fill are set to (uint) -1, as in
+** batchFeatureSelection(). Row shards only run FS_JMI and FS_CMIM. Returns
+** outputFeatures, or NULL if the criterion isn't supported by the shards or
+** a worker failed, in which case the shards should be freed.
+**
+** shardedJMI() and shardedCMIM() are shardedSearch() with FS_JMI and FS_CMIM.
+** Over row shards each round sends one request naming the last selected
+** feature and the remaining candidates to every worker, so there is one round
+** trip per selected feature.
+*******************************************************************************/
+uint* shardedSearch(uint k, FEASTShards *shards, FSCriterion *criterion, uint *outputFeatures, double *featureScores);
+uint* shardedJMI(uint k, FEASTShards *shards, uint *outputFeatures, double *featureScores);
+uint* shardedCMIM(uint k, FEASTShards *shards, uint *outputFeatures, double *featureScores);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
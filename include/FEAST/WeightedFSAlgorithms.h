@@ -7,6 +7,7 @@
 ** Created - 27/06/2011
 ** Updated - 14/09/2016 - Added double and uint entry points for all functions.
 **           18/12/2016 - Added an output variable for the feature scores.
+**           17/10/2026 - Added *WithOptions entry points, see FSOptions.h.
 **
 ** Part of the FEAture Selection Toolbox (FEAST), please reference
 ** "Feature Selection via Joint Likelihood"
@@ -58,16 +59,18 @@
  * Each algorithm uses a forward search, and selects the feature which has
  * the maxmimum MI with the labels first.
  *
- * All the algorithms except CMIM use an optimised variant which caches the
- * previously calculated MI values. This trades space for time, but can 
- * allocate large amounts of memory. CMIM uses the optimised implementation
- * given in Fleuret (2004). 
+ * The algorithms which sum a term over the selected features keep a running
+ * score for each candidate feature, so each iteration only calculates the
+ * term for the most recently selected feature. This uses memory linear in the
+ * number of features. CMIM uses the optimised implementation given in 
+ * Fleuret (2004). 
  *****************************************************************************/
 
 #ifndef __WFSAlgorithms_H
 #define __WFSAlgorithms_H
 
 #include "MIToolbox/MIToolbox.h"
+#include "FEAST/FSOptions.h"
 
 /*******************************************************************************
 ** weightedCMIM() implements a discrete version of the 
@@ -78,6 +81,7 @@
 ** F. Fleuret, JMLR (2004)
 *******************************************************************************/
 uint* weightedCMIM(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, uint *outputFeatures, double *featureScores);
+uint* weightedCMIMWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, uint *outputFeatures, double *featureScores, FSOptions *options);
 double* discWeightedCMIM(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *weightVector, double *outputFeatures, double *featureScores);
 
 /*******************************************************************************
@@ -87,12 +91,14 @@ double* discWeightedCMIM(uint k, uint noOfSamples, uint noOfFeatures, double **f
 ** H. Yang and J. Moody, NIPS (1999)
 *******************************************************************************/
 uint* weightedJMI(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, uint *outputFeatures, double *featureScores);
+uint* weightedJMIWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, uint *outputFeatures, double *featureScores, FSOptions *options);
 double* discWeightedJMI(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *weightVector, double *outputFeatures, double *featureScores);
 
 /*******************************************************************************
 ** WeightedMIM() implements the MIM criterion using a greedy forward search
 *******************************************************************************/
 uint* weightedMIM(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, uint *outputFeatures, double *featureScores);
+uint* weightedMIMWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, uint *outputFeatures, double *featureScores, FSOptions *options);
 double* discWeightedMIM(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *weightVector, double *outputFeatures, double *featureScores);
 
 /*******************************************************************************
@@ -103,6 +109,7 @@ double* discWeightedMIM(uint k, uint noOfSamples, uint noOfFeatures, double **fe
 ** P. Meyer and G. Bontempi, (2006)
 *******************************************************************************/
 uint* weightedDISR(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, uint *outputFeatures, double *featureScores);
+uint* weightedDISRWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, uint *outputFeatures, double *featureScores, FSOptions *options);
 double* discWeightedDISR(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *weightVector, double *outputFeatures, double *featureScores);
 
 /*******************************************************************************
@@ -112,6 +119,7 @@ double* discWeightedDISR(uint k, uint noOfSamples, uint noOfFeatures, double **f
 ** there was not enough information to select a feature.
 *******************************************************************************/
 int* weightedCondMI(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, int *outputFeatures, double *featureScores);
+int* weightedCondMIWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, int *outputFeatures, double *featureScores, FSOptions *options);
 double* discWeightedCondMI(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *weightVector, double *outputFeatures, double *featureScores);
 
 #endif
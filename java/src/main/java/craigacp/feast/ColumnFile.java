@@ -0,0 +1,261 @@
+/*
+** ColumnFile.java
+**
+** Initial Version - 17/10/2026
+** Author - Adam Pocock
+** 
+** Part of the FEAture Selection Toolbox (FEAST), please reference
+** "Conditional Likelihood Maximisation: A Unifying Framework for Information
+** Theoretic Feature Selection"
+** G. Brown, A. Pocock, M.-J. Zhao, M. Lujan
+** Journal of Machine Learning Research (JMLR), 2012
+**
+** Please check www.github.com/Craigacp/FEAST for updates.
+** 
+** Copyright (c) 2010-2017, A. Pocock, G. Brown, The University of Manchester
+** All rights reserved.
+** 
+** Redistribution and use in source and binary forms, with or without modification,
+** are permitted provided that the following conditions are met:
+** 
+**   - Redistributions of source code must retain the above copyright notice, this 
+**     list of conditions and the following disclaimer.
+**   - Redistributions in binary form must reproduce the above copyright notice, 
+**     this list of conditions and the following disclaimer in the documentation 
+**     and/or other materials provided with the distribution.
+**   - Neither the name of The University of Manchester nor the names of its 
+**     contributors may be used to endorse or promote products derived from this 
+**     software without specific prior written permission.
+** 
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+** ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+** ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+** (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+** LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+** ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+** SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+*/
+package craigacp.feast;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.nio.file.StandardOpenOption;
+import java.util.Arrays;
+
+/**
+ * Reads and writes the FEAST binary column file format described in
+ * FEAST/FSFile.h, so datasets can be loaded without parsing any text.
+ * <p>
+ * The file stores each feature as a contiguous column of 1, 2 or 4 byte
+ * values in the native byte order, with the label column last. Files written
+ * here can be memory mapped by the native library and vice versa.
+ *
+ * @author craigacp
+ */
+public final class ColumnFile {
+
+    private static final byte[] MAGIC = "FEASTCOL".getBytes(StandardCharsets.US_ASCII);
+    private static final int VERSION = 1;
+    private static final int ALIGNMENT = 4096;
+    private static final int HEADER_FIELDS = 4;
+
+    private ColumnFile() {
+    }
+
+    /**
+     * Checks if the file starts with the column file magic string.
+     * @param filename The file to check.
+     * @return True if the file looks like a column file.
+     * @throws IOException If the file could not be read.
+     */
+    public static boolean isColumnFile(String filename) throws IOException {
+        try (FileChannel channel = FileChannel.open(Paths.get(filename), StandardOpenOption.READ)) {
+            ByteBuffer magic = ByteBuffer.allocate(MAGIC.length);
+            while (magic.hasRemaining() && (channel.read(magic) != -1)) { }
+            return !magic.hasRemaining() && Arrays.equals(magic.array(), MAGIC);
+        }
+    }
+
+    /**
+     * Reads a column file. The columns are mapped one at a time and widened
+     * into the int arrays used by the FEAST API.
+     * @param filename The file to read.
+     * @return A Dataset containing the features and the labels.
+     * @throws IOException If the file could not be read, or is not a valid column file.
+     */
+    public static Dataset read(String filename) throws IOException {
+        try (FileChannel channel = FileChannel.open(Paths.get(filename), StandardOpenOption.READ)) {
+            ByteBuffer header = ByteBuffer.allocate(MAGIC.length + 4 * HEADER_FIELDS).order(ByteOrder.nativeOrder());
+            readFully(channel, header, 0);
+            byte[] magic = new byte[MAGIC.length];
+            header.get(magic);
+            int version = header.getInt();
+            int noOfSamples = header.getInt();
+            int noOfFeatures = header.getInt();
+            int alignment = header.getInt();
+            if (!Arrays.equals(magic, MAGIC) || (version != VERSION) || (alignment != ALIGNMENT)
+                    || (noOfSamples < 0) || (noOfFeatures < 0)) {
+                throw new IOException(filename + " is not a FEAST column file.");
+            }
+
+            ByteBuffer columnInfo = ByteBuffer.allocate(bufferSize(8L * (noOfFeatures + 1L), filename)).order(ByteOrder.nativeOrder());
+            readFully(channel, columnInfo, header.capacity());
+
+            long expectedSize = headerSize(noOfFeatures);
+            for (int i = 0; i <= noOfFeatures; i++) {
+                int width = columnInfo.getInt(8 * i);
+                if ((width != 1) && (width != 2) && (width != 4)) {
+                    throw new IOException(filename + " has an invalid column width " + width + ".");
+                }
+                expectedSize += alignedSize((long) noOfSamples * width);
+            }
+            if (channel.size() < expectedSize) {
+                throw new IOException(filename + " is truncated.");
+            }
+
+            int[][] columns = new int[noOfFeatures + 1][];
+            long position = headerSize(noOfFeatures);
+            for (int i = 0; i <= noOfFeatures; i++) {
+                int width = columnInfo.getInt(8 * i);
+                long length = (long) noOfSamples * width;
+                MappedByteBuffer buffer = channel.map(FileChannel.MapMode.READ_ONLY, position, bufferSize(length, filename));
+                buffer.order(ByteOrder.nativeOrder());
+                columns[i] = widenColumn(buffer, width, noOfSamples);
+                position += alignedSize(length);
+            }
+
+            return new Dataset(columns[noOfFeatures], Arrays.copyOf(columns, noOfFeatures));
+        }
+    }
+
+    /**
+     * Writes a dataset as a column file. Each column is stored at the
+     * narrowest width which holds its largest value.
+     * @param filename The file to write.
+     * @param dataset The dataset, with the features as columns and the labels.
+     * @throws IOException If the file could not be written.
+     */
+    public static void write(String filename, Dataset dataset) throws IOException {
+        int noOfSamples = dataset.labels.length;
+        int noOfFeatures = dataset.data.length;
+        Path path = Paths.get(filename);
+
+        try (FileChannel channel = FileChannel.open(path, StandardOpenOption.CREATE,
+                StandardOpenOption.TRUNCATE_EXISTING, StandardOpenOption.WRITE)) {
+            ByteBuffer header = ByteBuffer.allocate(bufferSize(headerSize(noOfFeatures), filename)).order(ByteOrder.nativeOrder());
+            header.put(MAGIC);
+            header.putInt(VERSION);
+            header.putInt(noOfSamples);
+            header.putInt(noOfFeatures);
+            header.putInt(ALIGNMENT);
+
+            for (int i = 0; i <= noOfFeatures; i++) {
+                int[] column = i < noOfFeatures ? dataset.data[i] : dataset.labels;
+                if (column.length != noOfSamples) {
+                    throw new IllegalArgumentException("Feature " + i + " has " + column.length + " values, expected " + noOfSamples);
+                }
+                int numStates = maxState(column);
+                header.putInt(columnWidth(numStates));
+                header.putInt(numStates);
+            }
+            header.clear();
+            writeFully(channel, header);
+
+            for (int i = 0; i <= noOfFeatures; i++) {
+                int[] column = i < noOfFeatures ? dataset.data[i] : dataset.labels;
+                int width = columnWidth(maxState(column));
+                ByteBuffer buffer = ByteBuffer.allocate(bufferSize(alignedSize((long) noOfSamples * width), filename)).order(ByteOrder.nativeOrder());
+                for (int value : column) {
+                    if (width == 1) {
+                        buffer.put((byte) value);
+                    } else if (width == 2) {
+                        buffer.putShort((short) value);
+                    } else {
+                        buffer.putInt(value);
+                    }
+                }
+                buffer.clear();
+                writeFully(channel, buffer);
+            }
+        }
+    }
+
+    private static int[] widenColumn(ByteBuffer buffer, int width, int noOfSamples) {
+        int[] column = new int[noOfSamples];
+        if (width == 1) {
+            for (int i = 0; i < noOfSamples; i++) {
+                column[i] = buffer.get(i) & 0xFF;
+            }
+        } else if (width == 2) {
+            for (int i = 0; i < noOfSamples; i++) {
+                column[i] = buffer.getShort(2 * i) & 0xFFFF;
+            }
+        } else {
+            buffer.asIntBuffer().get(column);
+        }
+        return column;
+    }
+
+    private static int maxState(int[] column) {
+        int max = 0;
+        for (int value : column) {
+            if (value < 0) {
+                throw new IllegalArgumentException("Column files only store non-negative values, found " + value);
+            }
+            max = Math.max(max, value);
+        }
+        return max + 1;
+    }
+
+    private static int columnWidth(int numStates) {
+        if (numStates <= 256) {
+            return 1;
+        } else if (numStates <= 65536) {
+            return 2;
+        } else {
+            return 4;
+        }
+    }
+
+    private static long alignedSize(long size) {
+        return ((size + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+    }
+
+    private static long headerSize(int noOfFeatures) {
+        return alignedSize(MAGIC.length + 4L * (HEADER_FIELDS + 2L * (noOfFeatures + 1L)));
+    }
+
+    private static int bufferSize(long size, String filename) throws IOException {
+        if (size > Integer.MAX_VALUE) {
+            throw new IOException(filename + " needs a buffer of " + size + " bytes, more than the " + Integer.MAX_VALUE + " a buffer can hold.");
+        }
+        return (int) size;
+    }
+
+    private static void readFully(FileChannel channel, ByteBuffer buffer, long position) throws IOException {
+        while (buffer.hasRemaining()) {
+            int read = channel.read(buffer, position + buffer.position());
+            if (read == -1) {
+                throw new IOException("Unexpected end of file.");
+            }
+        }
+        buffer.flip();
+    }
+
+    private static void writeFully(FileChannel channel, ByteBuffer buffer) throws IOException {
+        while (buffer.hasRemaining()) {
+            channel.write(buffer);
+        }
+    }
+
+}
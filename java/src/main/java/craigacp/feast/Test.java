@@ -101,9 +101,9 @@ public class Test {
         buffer.append("     -c {CIFE,CMIM,CondMI,DISR,ICAP,JMI,MIFS,MIM,mRMR}\n");
         buffer.append("         Selection criteria to use.\n");
         buffer.append("     -f <filename>\n");
-        buffer.append("         CSV file to read.\n");
+        buffer.append("         CSV or FEAST column file to read.\n");
         buffer.append("     -l <int>\n");
-        buffer.append("         Index of the label in the csv.\n");
+        buffer.append("         Index of the label in the csv. Not used for column files.\n");
         buffer.append("     -n <int>\n");
         buffer.append("         Number of features to select. Defaults to a full ranking.\n");
         buffer.append("     -w \n");
@@ -185,7 +185,25 @@ public class Test {
         }
 
         Dataset dataset = null;
-        if ((filename != null) && (labelIndex != -1)) {
+        boolean columnFile = false;
+        if (filename != null) {
+            try {
+                columnFile = ColumnFile.isColumnFile(filename);
+            } catch (IOException e) {
+                System.err.println("IOException when reading from " + filename + ". " + e.toString());
+                return;
+            }
+        }
+        if (columnFile) {
+            try {
+                dataset = ColumnFile.read(filename);
+                System.out.println("Dataset loaded from " + filename);
+                System.out.println("Found " + dataset.labels.length + " labels and " + dataset.data.length + " features.");
+            } catch (IOException e) {
+                System.err.println("IOException when reading from " + filename + ". " + e.toString());
+                return;
+            }
+        } else if ((filename != null) && (labelIndex != -1)) {
             dataset = readDataset(filename, labelIndex);
         } else {
             System.err.println("Please supply a filename and a label index.");
@@ -42,77 +42,149 @@
 #include <jni.h>
 #include <stdlib.h>
 #include <FEAST/FSAlgorithms.h>
+#include <FEAST/FSBatch.h>
 #include "FEASTJNIUtil.h"
 #include "craigacp_feast_FEAST.h"
 
 /*
- * Class:     craigacp_feast_FEAST
- * Method:    BetaGamma
- * Signature: (I[[I[IDD)Lcraigacp/feast/ScoredFeatures;
+ * Runs one criterion through checkedFeatureSelection and wraps the result in a
+ * ScoredFeatures. Every array pinned here is released before returning, and
+ * bad inputs throw an IllegalArgumentException rather than crashing the JVM,
+ * so it can be called from many Java threads at once.
  */
-JNIEXPORT jobject JNICALL Java_craigacp_feast_FEAST_BetaGamma(JNIEnv * env, jclass clazz, jint numToSelect, jobjectArray javaData, jintArray javaLabels, jdouble beta, jdouble gamma) {
+static jobject runFeatureSelection(JNIEnv *env, FSCriterion *criterion, jint numToSelect, jobjectArray javaData, jintArray javaLabels) {
     jint *labels;
     jint **data;
+    jintArray *features;
     jsize numLabels, numFeatures;
-    double *scores;
-    int *indices;
+    double *scores = NULL;
+    int *indices = NULL;
     jdoubleArray javaScores;
-    jintArray javaIndices, feature;
+    jintArray javaIndices;
     jclass cls;
     jmethodID midInit;
-    jobject scoredFeatures;
-    int i;
-    
+    jobject scoredFeatures = NULL;
+    int status = FS_ERROR_ARGUMENT;
+    int i, numPinned = 0;
+
+    numFeatures = (*env)->GetArrayLength(env, javaData);
+    numLabels = (*env)->GetArrayLength(env, javaLabels);
+    if ((numToSelect < 0) || (numToSelect > numFeatures)) {
+        throwIllegalArgumentException(env, "The number of features to select must be between 0 and the number of features");
+        return NULL;
+    }
+
     /* Extract a C array for the labels */
     labels = (*env)->GetIntArrayElements(env, javaLabels, NULL);
     if (labels == NULL) {
         throwOutOfMemoryError(env, "Could not allocate array to hold the labels");
+        return NULL;
     }
-    numLabels = (*env)->GetArrayLength(env, javaLabels);
 
     /* Extract a C array for the data */
-    numFeatures = (*env)->GetArrayLength(env, javaData);
-    data = calloc(numFeatures, sizeof(int*));
-    for (i = 0; i < numFeatures; i++) {
-        feature = (jintArray)(*env)->GetObjectArrayElement(env, javaData, i);
-        data[i] = (*env)->GetIntArrayElements(env, feature, NULL);
+    data = calloc(numFeatures + 1, sizeof(jint*));
+    features = calloc(numFeatures + 1, sizeof(jintArray));
+    if ((data == NULL) || (features == NULL)) {
+        throwOutOfMemoryError(env, "Could not allocate array to hold the data");
+    } else {
+        for (numPinned = 0; numPinned < numFeatures; numPinned++) {
+            features[numPinned] = (jintArray)(*env)->GetObjectArrayElement(env, javaData, numPinned);
+            if ((features[numPinned] == NULL) || ((*env)->GetArrayLength(env, features[numPinned]) != numLabels)) {
+                throwIllegalArgumentException(env, "Every feature must have one value per label");
+                break;
+            }
+            data[numPinned] = (*env)->GetIntArrayElements(env, features[numPinned], NULL);
+            if (data[numPinned] == NULL) {
+                throwOutOfMemoryError(env, "Could not allocate array to hold a feature");
+                break;
+            }
+        }
     }
 
-    /* Malloc space for indices and scores */
-    scores = calloc(numToSelect, sizeof(double));
-    indices = calloc(numToSelect, sizeof(int));
+    if (numPinned == numFeatures) {
+        /* Malloc space for indices and scores */
+        scores = calloc(numToSelect + 1, sizeof(double));
+        indices = calloc(numToSelect + 1, sizeof(int));
+        if ((scores == NULL) || (indices == NULL)) {
+            throwOutOfMemoryError(env, "Could not allocate arrays to hold the selected features");
+        } else {
+            /* int checkedFeatureSelection(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, FSCriterion *criterion, uint *outputFeatures, double *featureScores, FSOptions *options); */
+            /* A negative value becomes a uint of at least INT_MAX, which is rejected with FS_ERROR_STATES. */
+            status = checkedFeatureSelection(numToSelect,numLabels,numFeatures,(uint**)data,(uint*)labels,criterion,(uint*)indices,scores,NULL);
+            switch (status) {
+                case FS_OK:
+                    break;
+                case FS_ERROR_STATES:
+                    throwIllegalArgumentException(env, "The features and labels must be non-negative, with few enough states that their contingency tables fit in an int");
+                    break;
+                case FS_ERROR_MEMORY:
+                    throwOutOfMemoryError(env, "Could not allocate memory for the feature selection");
+                    break;
+                case FS_ERROR_ARGUMENT:
+                    /* The pointers and the number to select were checked above */
+                    if (numLabels == 0) {
+                        throwIllegalArgumentException(env, "The data must have at least one sample");
+                    } else {
+                        throwIllegalArgumentException(env, "Unknown feature selection criterion");
+                    }
+                    break;
+                default:
+                    throwIllegalArgumentException(env, "Feature selection failed with an unexpected error code");
+                    break;
+            }
+        }
+    }
 
-    /* uint* BetaGamma(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores, double beta, double gamma); */
-    /* The cast from int** to uint** could cause problems on different architectures.
-       The Java code above this should verify all integers are non-negative otherwise 
-       things will crash. */
-    BetaGamma(numToSelect,numLabels,numFeatures,(uint**)data,(uint*)labels,(uint*)indices,scores,beta,gamma);
-    free(data);
-    
-    /* Copy out the scores array */
-    javaScores = (*env)->NewDoubleArray(env, numToSelect);
-    if (javaScores == NULL) {
-        throwOutOfMemoryError(env, "Could not allocate array to hold the scores");
+    /* The inputs were only read, so nothing is copied back */
+    for (i = 0; i < numPinned; i++) {
+        (*env)->ReleaseIntArrayElements(env, features[i], data[i], JNI_ABORT);
+        (*env)->DeleteLocalRef(env, features[i]);
     }
-    (*env)->SetDoubleArrayRegion(env, javaScores, 0 , numToSelect, scores);
-    free(scores);
+    if ((numPinned < numFeatures) && (features != NULL) && (features[numPinned] != NULL)) {
+        (*env)->DeleteLocalRef(env, features[numPinned]);
+    }
+    (*env)->ReleaseIntArrayElements(env, javaLabels, labels, JNI_ABORT);
+    free(data);
+    free(features);
 
-    /* Copy out the indices array */
-    javaIndices = (*env)->NewIntArray(env, numToSelect);
-    if (javaIndices == NULL) {
-        throwOutOfMemoryError(env, "Could not allocate array to hold the indices");
+    if (status == FS_OK) {
+        /* Copy out the scores and indices arrays */
+        javaScores = (*env)->NewDoubleArray(env, numToSelect);
+        javaIndices = (*env)->NewIntArray(env, numToSelect);
+        if ((javaScores == NULL) || (javaIndices == NULL)) {
+            throwOutOfMemoryError(env, "Could not allocate arrays to hold the scores and indices");
+        } else {
+            (*env)->SetDoubleArrayRegion(env, javaScores, 0 , numToSelect, scores);
+            (*env)->SetIntArrayRegion(env, javaIndices, 0 , numToSelect, indices);
+
+            /* Create the ScoredFeatures object and return it */
+            cls = (*env)->FindClass(env, "craigacp/feast/ScoredFeatures");
+            midInit = (*env)->GetMethodID(env, cls, "<init>", "([I[D)V");
+            scoredFeatures = (*env)->NewObject(env, cls, midInit, javaIndices, javaScores);
+        }
     }
-    (*env)->SetIntArrayRegion(env, javaIndices, 0 , numToSelect, indices);
+
+    free(scores);
     free(indices);
 
-    /* Create the ScoredFeatures object and return it */
-    cls = (*env)->FindClass(env, "craigacp/feast/ScoredFeatures");
-    midInit = (*env)->GetMethodID(env, cls, "<init>", "([I[D)V");
-    scoredFeatures = (*env)->NewObject(env, cls, midInit, javaIndices, javaScores);
-    
     return scoredFeatures;
 }
 
+/*
+ * Class:     craigacp_feast_FEAST
+ * Method:    BetaGamma
+ * Signature: (I[[I[IDD)Lcraigacp/feast/ScoredFeatures;
+ */
+JNIEXPORT jobject JNICALL Java_craigacp_feast_FEAST_BetaGamma(JNIEnv * env, jclass clazz, jint numToSelect, jobjectArray javaData, jintArray javaLabels, jdouble beta, jdouble gamma) {
+    FSCriterion criterion;
+
+    criterion.criterion = FS_BETAGAMMA;
+    criterion.betaParam = beta;
+    criterion.gammaParam = gamma;
+
+    return runFeatureSelection(env, &criterion, numToSelect, javaData, javaLabels);
+}
+
 /*
  * Class:     craigacp_feast_FEAST
  * Method:    feast
@@ -129,99 +201,37 @@ JNIEXPORT jobject JNICALL Java_craigacp_feast_FEAST_BetaGamma(JNIEnv * env, jcla
  * 
  */
 JNIEXPORT jobject JNICALL Java_craigacp_feast_FEAST_feast(JNIEnv * env, jclass clazz, jint flag, jint numToSelect, jobjectArray javaData, jintArray javaLabels) {
-    jint *labels;
-    jint **data;
-    jsize numLabels, numFeatures;
-    double *scores;
-    int *indices;
-    jdoubleArray javaScores;
-    jintArray javaIndices, feature;
-    jclass cls;
-    jmethodID midInit;
-    jobject scoredFeatures;
-    int i,j;
-    uint **udata;
-    uint *ulabels, *uindices;
-    
-    /* Extract a C array for the labels */
-    labels = (*env)->GetIntArrayElements(env, javaLabels, NULL);
-    if (labels == NULL) {
-        throwOutOfMemoryError(env, "Could not allocate array to hold the labels");
-    }
-    numLabels = (*env)->GetArrayLength(env, javaLabels);
-
-    /* Extract a C array for the data */
-    numFeatures = (*env)->GetArrayLength(env, javaData);
-    data = calloc(numFeatures, sizeof(int*));
-    for (i = 0; i < numFeatures; i++) {
-        feature = (jintArray)(*env)->GetObjectArrayElement(env, javaData, i);
-        data[i] = (*env)->GetIntArrayElements(env, feature, NULL);
-        for (j = 0; j < numLabels; j++) {
-            if (data[i][j] < 0) {
-                printf("Found negative value %d at location data[%d][%d]\n",data[i][j],i,j);
-            }
-        }
-    }
+    FSCriterion criterion;
 
-    /* Malloc space for indices and scores */
-    scores = calloc(numToSelect, sizeof(double));
-    indices = calloc(numToSelect, sizeof(int));
+    criterion.betaParam = 0.0;
+    criterion.gammaParam = 0.0;
 
-    udata = (uint **) data;
-    ulabels = (uint *) labels;
-    uindices = (uint *) indices;
-    /* The cast from int** to uint** could cause problems on different architectures.
-       The Java code above this should verify all integers are non-negative otherwise 
-       things will crash. */
     switch (flag) {
         case 1: /* CMIM */
-            /* uint* CMIM(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores); */
-            CMIM(numToSelect,numLabels,numFeatures,udata,ulabels,uindices,scores);
+            criterion.criterion = FS_CMIM;
             break;
         case 2: /* CondMI */
-            /* int* CondMI(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, int *outputFeatures, double *featureScores) */
-            CondMI(numToSelect,numLabels,numFeatures,udata,ulabels,indices,scores);
+            criterion.criterion = FS_CONDMI;
             break;
         case 3: /* DISR */
-            DISR(numToSelect,numLabels,numFeatures,udata,ulabels,uindices,scores);
+            criterion.criterion = FS_DISR;
             break;
         case 4: /* ICAP */
-            ICAP(numToSelect,numLabels,numFeatures,udata,ulabels,uindices,scores);
+            criterion.criterion = FS_ICAP;
             break;
         case 5: /* JMI */
-            JMI(numToSelect,numLabels,numFeatures,udata,ulabels,uindices,scores);
+            criterion.criterion = FS_JMI;
             break;
         case 6: /* MIM */
-            MIM(numToSelect,numLabels,numFeatures,udata,ulabels,uindices,scores);
+            criterion.criterion = FS_MIM;
             break;
         case 7: /* mRMR */
-            mRMR_D(numToSelect,numLabels,numFeatures,udata,ulabels,uindices,scores);
+            criterion.criterion = FS_MRMR_D;
             break;
         default:
-            printf("Unknown flag %d\n", flag);
+            throwIllegalArgumentException(env, "Unknown feature selection flag");
+            return NULL;
     }
-    free(data);
-    
-    /* Copy out the scores array */
-    javaScores = (*env)->NewDoubleArray(env, numToSelect);
-    if (javaScores == NULL) {
-        throwOutOfMemoryError(env, "Could not allocate array to hold the scores");
-    }
-    (*env)->SetDoubleArrayRegion(env, javaScores, 0 , numToSelect, scores);
-    free(scores);
 
-    /* Copy out the indices array */
-    javaIndices = (*env)->NewIntArray(env, numToSelect);
-    if (javaIndices == NULL) {
-        throwOutOfMemoryError(env, "Could not allocate array to hold the indices");
-    }
-    (*env)->SetIntArrayRegion(env, javaIndices, 0 , numToSelect, indices);
-    free(indices);
-
-    /* Create the ScoredFeatures object and return it */
-    cls = (*env)->FindClass(env, "craigacp/feast/ScoredFeatures");
-    midInit = (*env)->GetMethodID(env, cls, "<init>", "([I[D)V");
-    scoredFeatures = (*env)->NewObject(env, cls, midInit, javaIndices, javaScores);
-    
-    return scoredFeatures;
+    return runFeatureSelection(env, &criterion, numToSelect, javaData, javaLabels);
 }
@@ -11,3 +11,13 @@ jint throwOutOfMemoryError(JNIEnv *env, char *message)
     return (*env)->ThrowNew(env, exClass, message);
 }
 
+
+jint throwIllegalArgumentException(JNIEnv *env, char *message)
+{
+    jclass exClass;
+    char *className = "java/lang/IllegalArgumentException" ;
+
+    exClass = (*env)->FindClass(env, className);
+
+    return (*env)->ThrowNew(env, exClass, message);
+}
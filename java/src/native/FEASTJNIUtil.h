@@ -7,6 +7,7 @@ extern "C" {
 #endif
 
 jint throwOutOfMemoryError(JNIEnv *env, char *message);
+jint throwIllegalArgumentException(JNIEnv *env, char *message);
 
 #ifdef __cplusplus
 }
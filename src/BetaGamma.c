@@ -16,6 +16,13 @@
 **           22/02/2014 - Patched calloc.
 **           12/03/2016 - Changed initial value of maxMI to -1.0 to prevent segfaults when I(X;Y) = 0.0 for all X.
 **           17/12/2016 - Added feature scores.
+**           17/10/2026 - Added multi-threaded candidate scoring.
+**           17/10/2026 - Moved the class MI calculation into the shared parallel relevance pass.
+**           17/10/2026 - Replaced the k*noOfFeatures MI cache with a running score per feature.
+**           17/10/2026 - Switched the pairwise terms to the fused joint statistics kernel.
+**           17/10/2026 - Split out a column variant which reads compact 8/16 bit columns.
+**           17/10/2026 - Added the FEASTDataset entry point.
+**           17/10/2026 - Added lazy evaluation, pruning candidates whose partial score is below the best.
 **
 ** Author - Adam Pocock
 ** 
@@ -57,42 +64,49 @@
 
 #include "FEAST/FSAlgorithms.h"
 #include "FEAST/FSToolbox.h"
+#include "FSInternal.h"
 
 /* MIToolbox includes */
 #include "MIToolbox/ArrayOperations.h"
 #include "MIToolbox/MutualInformation.h"
 
-uint* BetaGamma(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores, double betaParam, double gammaParam) {
+uint* columnBetaGamma(uint k, FSColumnSet *set, uint *outputFeatures, double *featureScores, double betaParam, double gammaParam, FSOptions *options) {
+    uint noOfSamples = set->noOfSamples;
+    uint noOfFeatures = set->noOfFeatures;
     char *selectedFeatures = (char *) checkedCalloc(noOfFeatures,sizeof(char));
 
     /*holds the class MI values*/
     double *classMI = (double *) checkedCalloc(noOfFeatures,sizeof(double));
 
-    /*holds the intra feature MI values*/
-    int sizeOfMatrix = k*noOfFeatures;
-    double *featureMIMatrix = (double *) checkedCalloc(sizeOfMatrix,sizeof(double));
+    /*holds the sum of the redundancy terms for each feature*/
+    double *totalFeatureMI = (double *) checkedCalloc(noOfFeatures,sizeof(double));
 
     /*Changed to ensure it always picks a feature*/
     double maxMI = -1.0;
     int maxMICounter = -1;
 
-    double score, currentScore, totalFeatureMI;
-    int currentHighestFeature, arrayPosition;
+    double score;
+    int currentHighestFeature;
+
+    int numThreads = numberOfThreads(options);
 
-    int i, j, m;
+    /*lazy evaluation only calculates the terms a candidate needs to beat the best score*/
+    int lazy = (options != NULL) && options->lazyEvaluation && (betaParam >= 0) && (gammaParam <= 0);
+    /*the number of selected features whose terms are in each running score*/
+    uint *lastUsedFeature = NULL;
+    /*the candidates in descending order of class MI*/
+    int *candidateOrder = NULL;
 
-    for (i = 0; i < sizeOfMatrix; i++) {
-        featureMIMatrix[i] = -1;
-    }/*for featureMIMatrix - blank to -1*/
+    int i;
 
     /***********************************************************
      ** SETUP COMPLETE
      ** Algorithm starts here
      ***********************************************************/
 
-    for (i = 0; i < noOfFeatures; i++) {
-        classMI[i] = calcMutualInformation(featureMatrix[i], classColumn, noOfSamples);
+    calculateClassMI(set, classMI, options);
 
+    for (i = 0; i < noOfFeatures; i++) {
         if (classMI[i] > maxMI) {
             maxMI = classMI[i];
             maxMICounter = i;
@@ -103,6 +117,11 @@ uint* BetaGamma(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatri
     outputFeatures[0] = maxMICounter;
     featureScores[0] = maxMI;
 
+    if (lazy) {
+        lastUsedFeature = (uint *) checkedCalloc(noOfFeatures,sizeof(uint));
+        candidateOrder = rankByScore(classMI, noOfFeatures);
+    }
+
     /*************
      ** Now we have populated the classMI array, and selected the highest
      ** MI feature as the first output feature
@@ -117,36 +136,97 @@ uint* BetaGamma(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatri
          ************************************************************/
         score = -DBL_MAX;
         currentHighestFeature = 0;
-        currentScore = 0.0;
-        totalFeatureMI = 0.0;
 
-        for (j = 0; j < noOfFeatures; j++) {
-            /*if we haven't selected j*/
-            if (!selectedFeatures[j]) {
-                currentScore = classMI[j];
-                totalFeatureMI = 0.0;
-
-                for (m = 0; m < i; m++) {
-                    arrayPosition = m * noOfFeatures + j;
-                    if (featureMIMatrix[arrayPosition] == -1) {
-                        /*double calcMutualInformation(uint *firstVector, uint *secondVector, int vectorLength);*/
-                        featureMIMatrix[arrayPosition] = betaParam * calcMutualInformation(featureMatrix[outputFeatures[m]], featureMatrix[j], noOfSamples);
-
-                        /*double calcConditionalMutualInformation(uint *firstVector, uint *targetVector, uint *conditionVector, int vectorLength);*/
-                        featureMIMatrix[arrayPosition] -= gammaParam * calcConditionalMutualInformation(featureMatrix[outputFeatures[m]], featureMatrix[j], classColumn, noOfSamples);
-                    }/*if not already known*/
-
-                    totalFeatureMI += featureMIMatrix[arrayPosition];
-                }/*for the number of already selected features*/
-
-                currentScore -= (totalFeatureMI);
-
-                if (currentScore > score) {
-                    score = currentScore;
-                    currentHighestFeature = j;
-                }
-            }/*if j is unselected*/
-        }/*for number of features*/
+        if (lazy) {
+            #pragma omp parallel num_threads(numThreads) if (numThreads > 1)
+            {
+                JointStatistics stats;
+                double currentScore, redundancy, bound;
+                int j, o;
+
+                #pragma omp for schedule(dynamic,FS_CHUNK_SIZE)
+                for (o = 0; o < noOfFeatures; o++) {
+                    j = candidateOrder[o];
+                    /*if we haven't selected j*/
+                    if (!selectedFeatures[j]) {
+                        /*score is the best exact score found so far, so it only grows*/
+                        #pragma omp atomic read
+                        bound = score;
+
+                        currentScore = classMI[j];
+                        currentScore -= (totalFeatureMI[j]);
+
+                        /*with betaParam >= 0 and gammaParam <= 0 the missing terms are non-negative up to rounding, so with a slack for each the partial sum bounds the final score*/
+                        while ((currentScore + FS_BOUND_TOLERANCE * (betaParam - gammaParam) * (i - lastUsedFeature[j]) >= bound) && (lastUsedFeature[j] < i)) {
+                            /*JointStatistics calcJointStatistics(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn, int vectorLength);*/
+                            stats = calcJointStatistics(set->features + outputFeatures[lastUsedFeature[j]], set->features + j, &(set->classColumn), noOfSamples);
+                            redundancy = betaParam * stats.mi;
+                            redundancy -= gammaParam * stats.cmi;
+                            totalFeatureMI[j] += redundancy;
+
+                            lastUsedFeature[j] += 1;
+                            currentScore = classMI[j];
+                            currentScore -= (totalFeatureMI[j]);
+
+                            #pragma omp atomic read
+                            bound = score;
+                        }/*while the bound may still win & terms are missing*/
+
+                        if ((lastUsedFeature[j] == i) && (currentScore >= bound)) {
+                            #pragma omp critical (BetaGammaScore)
+                            {
+                                if (BETTER_CANDIDATE(currentScore,j,score,currentHighestFeature)) {
+                                    #pragma omp atomic write
+                                    score = currentScore;
+                                    currentHighestFeature = j;
+                                }
+                            }/*raise the shared score*/
+                        }/*if the score is exact and may still win*/
+                    }/*if j is unselected*/
+                }/*for each candidate in order of relevance*/
+            }/*parallel lazy scoring of the candidates*/
+        } else {
+            #pragma omp parallel num_threads(numThreads) if (numThreads > 1)
+            {
+                double threadScore = -DBL_MAX;
+                int threadHighestFeature = 0;
+                JointStatistics stats;
+                double currentScore, redundancy;
+                int j;
+
+                #pragma omp for schedule(dynamic,FS_CHUNK_SIZE)
+                for (j = 0; j < noOfFeatures; j++) {
+                    /*if we haven't selected j*/
+                    if (!selectedFeatures[j]) {
+                        currentScore = classMI[j];
+
+                        /*only the term for the last selected feature is new*/
+                        /*JointStatistics calcJointStatistics(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn, int vectorLength);*/
+                        stats = calcJointStatistics(set->features + outputFeatures[i-1], set->features + j, &(set->classColumn), noOfSamples);
+
+                        redundancy = betaParam * stats.mi;
+                        redundancy -= gammaParam * stats.cmi;
+
+                        totalFeatureMI[j] += redundancy;
+
+                        currentScore -= (totalFeatureMI[j]);
+
+                        if (BETTER_CANDIDATE(currentScore,j,threadScore,threadHighestFeature)) {
+                            threadScore = currentScore;
+                            threadHighestFeature = j;
+                        }
+                    }/*if j is unselected*/
+                }/*for number of features*/
+
+                #pragma omp critical (BetaGammaReduce)
+                {
+                    if (BETTER_CANDIDATE(threadScore,threadHighestFeature,score,currentHighestFeature)) {
+                        score = threadScore;
+                        currentHighestFeature = threadHighestFeature;
+                    }
+                }/*reduce the thread maxima*/
+            }/*parallel scoring of the candidates*/
+        }
 
         selectedFeatures[currentHighestFeature] = 1;
         outputFeatures[i] = currentHighestFeature;
@@ -155,47 +235,62 @@ uint* BetaGamma(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatri
     }/*for the number of features to select*/
 
     FREE_FUNC(classMI);
-    FREE_FUNC(featureMIMatrix);
+    FREE_FUNC(totalFeatureMI);
     FREE_FUNC(selectedFeatures);
 
+    if (lazy) {
+        FREE_FUNC(lastUsedFeature);
+        FREE_FUNC(candidateOrder);
+        lastUsedFeature = NULL;
+        candidateOrder = NULL;
+    }
+
     classMI = NULL;
-    featureMIMatrix = NULL;
+    totalFeatureMI = NULL;
     selectedFeatures = NULL;
 
     return outputFeatures;
+}/*columnBetaGamma(uint,FSColumnSet*,uint[],double[],double,double,FSOptions*)*/
+
+uint* BetaGammaWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores, double betaParam, double gammaParam, FSOptions *options) {
+    FSColumnSet set;
+
+    createColumnSet(noOfSamples, noOfFeatures, featureMatrix, classColumn, options, &set);
+
+    columnBetaGamma(k, &set, outputFeatures, featureScores, betaParam, gammaParam, options);
+
+    freeColumnSet(&set);
+
+    return outputFeatures;
+}/*BetaGammaWithOptions(uint,uint,uint,uint[][],uint[],uint[],double[],double,double,FSOptions*)*/
+
+uint* BetaGamma(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores, double betaParam, double gammaParam) {
+    return BetaGammaWithOptions(k, noOfSamples, noOfFeatures, featureMatrix, classColumn, outputFeatures, featureScores, betaParam, gammaParam, NULL);
 }/*BetaGamma(uint,uint,uint,uint[][],uint[],uint[],double[],double,double)*/
 
+uint* datasetBetaGamma(uint k, FEASTDataset *dataset, uint *outputFeatures, double *featureScores, double betaParam, double gammaParam, FSOptions *options) {
+    columnBetaGamma(searchLength(dataset,k), searchColumnSet(dataset), outputFeatures, featureScores, betaParam, gammaParam, options);
+    return restoreFeatureIndices(dataset, k, outputFeatures, featureScores);
+}/*datasetBetaGamma(uint,FEASTDataset*,uint[],double[],double,double,FSOptions*)*/
+
 double* discBetaGamma(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *outputFeatures, double *featureScores, double beta, double gamma) {
-    uint *intFeatures = (uint *) checkedCalloc(noOfSamples*noOfFeatures,sizeof(uint));
-    uint *intClass = (uint *) checkedCalloc(noOfSamples,sizeof(uint));
+    FSColumnSet set;
     uint *intOutputs = (uint *) checkedCalloc(k,sizeof(uint));
 
-    uint **intFeature2D = (uint**) checkedCalloc(noOfFeatures,sizeof(uint*));
-
     int i;
 
-    for (i = 0; i < noOfFeatures; i++) {
-        intFeature2D[i] = intFeatures + i*noOfSamples;
-        normaliseArray(featureMatrix[i],intFeature2D[i],noOfSamples);
-    }
-
-    normaliseArray(classColumn,intClass,noOfSamples);
+    normaliseColumnSet(noOfSamples, noOfFeatures, featureMatrix, classColumn, &set);
 
-    BetaGamma(k, noOfSamples, noOfFeatures, intFeature2D, intClass, intOutputs, featureScores, beta, gamma);
+    columnBetaGamma(k, &set, intOutputs, featureScores, beta, gamma, NULL);
 
     for (i = 0; i < k; i++) {
         outputFeatures[i] = intOutputs[i];
     }
 
-    FREE_FUNC(intFeatures);
-    FREE_FUNC(intClass);
+    freeColumnSet(&set);
     FREE_FUNC(intOutputs);
-    FREE_FUNC(intFeature2D);
 
-    intFeatures = NULL;
-    intClass = NULL;
     intOutputs = NULL;
-    intFeature2D = NULL;
 
     return outputFeatures;
 }/*discBetaGamma(uint,uint,uint,double[][],double[],double[],double[],beta,gamma)*/
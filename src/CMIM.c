@@ -12,6 +12,11 @@
 **           22/02/2014 - Patched calloc.
 **           12/03/2016 - Changed initial value of maxMI to -1.0 to prevent segfaults when I(X;Y) = 0.0 for all X.
 **           17/12/2016 - Added feature scores.
+**           17/10/2026 - Moved the class MI calculation into the shared parallel relevance pass.
+**           17/10/2026 - Switched the pairwise terms to the fused joint statistics kernel.
+**           17/10/2026 - Split out a column variant which reads compact 8/16 bit columns.
+**           17/10/2026 - Added the FEASTDataset entry point.
+**           17/10/2026 - Parallelised the candidate loop, sharing the best score as the pruning bound.
 **
 ** Author - Adam Pocock
 ** 
@@ -53,12 +58,15 @@
 
 #include "FEAST/FSAlgorithms.h"
 #include "FEAST/FSToolbox.h"
+#include "FSInternal.h"
 
 /* MIToolbox includes */
 #include "MIToolbox/ArrayOperations.h"
 #include "MIToolbox/MutualInformation.h"
 
-uint* CMIM(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores) {
+uint* columnCMIM(uint k, FSColumnSet *set, uint *outputFeatures, double *featureScores, FSOptions *options) {
+    uint noOfSamples = set->noOfSamples;
+    uint noOfFeatures = set->noOfFeatures;
     char *selectedFeatures = (char *) checkedCalloc(noOfFeatures,sizeof(char));
     /*holds the class MI values
      **the class MI doubles as the partial score from the CMIM paper
@@ -67,18 +75,20 @@ uint* CMIM(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, ui
     /*in the CMIM paper, m = lastUsedFeature*/
     uint *lastUsedFeature = (uint *) checkedCalloc(noOfFeatures,sizeof(uint));
 
-    double score, conditionalInfo;
-    uint currentFeature;
+    double score;
+    int currentHighestFeature;
+
+    int numThreads = numberOfThreads(options);
 
     /*Changed to ensure it always picks a feature*/
     double maxMI = -1.0;
     int maxMICounter = -1;
 
-    int i,j;
+    int i;
 
-    for (i = 0; i < noOfFeatures; i++) {
-        classMI[i] = calcMutualInformation(featureMatrix[i],classColumn,noOfSamples);
+    calculateClassMI(set, classMI, options);
 
+    for (i = 0; i < noOfFeatures; i++) {
         if (classMI[i] > maxMI) {
             maxMI = classMI[i];
             maxMICounter = i;
@@ -97,69 +107,105 @@ uint* CMIM(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, ui
 
     for (i = 1; i < k; i++) {
         score = -1.0;
-
-        for (j = 0; j < noOfFeatures; j++) {
-            if (selectedFeatures[j] == 0) {
-                while ((classMI[j] > score) && (lastUsedFeature[j] < i)) {
-                    /*double calcConditionalMutualInformation(uint *firstVector, uint *targetVector, uint *conditionVector, int vectorLength);*/
-                    currentFeature = outputFeatures[lastUsedFeature[j]];
-                    conditionalInfo = calcConditionalMutualInformation(featureMatrix[j],classColumn,featureMatrix[currentFeature],noOfSamples);
-                    if (classMI[j] > conditionalInfo) {
-                        classMI[j] = conditionalInfo;
-                    }/*reset classMI*/
-                    /*moved due to C indexing from 0 rather than 1*/
-                    lastUsedFeature[j] += 1;
-                }/*while partial score greater than score & not reached last feature*/
-                if (classMI[j] > score) {
-                    score = classMI[j];
-                    featureScores[i] = score;
-                    outputFeatures[i] = j;
-                }/*if partial score still greater than score*/
-            }
-        }/*for number of features*/
-        selectedFeatures[outputFeatures[i]] = 1;
+        currentHighestFeature = 0;
+
+        #pragma omp parallel num_threads(numThreads) if (numThreads > 1)
+        {
+            double bound, conditionalInfo;
+            uint currentFeature;
+            int j;
+
+            #pragma omp for schedule(dynamic,FS_CHUNK_SIZE)
+            for (j = 0; j < noOfFeatures; j++) {
+                if (selectedFeatures[j] == 0) {
+                    /*score is the best exact score any thread has found so far, so it only grows*/
+                    #pragma omp atomic read
+                    bound = score;
+
+                    /*a partial score equal to the bound may still win on index, so only strictly lower ones stop*/
+                    while ((classMI[j] >= bound) && (lastUsedFeature[j] < i)) {
+                        /*JointStatistics calcJointStatistics(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn, int vectorLength);*/
+                        currentFeature = outputFeatures[lastUsedFeature[j]];
+                        conditionalInfo = calcJointStatistics(set->features + currentFeature,set->features + j,&(set->classColumn),noOfSamples).classCMI;
+                        if (classMI[j] > conditionalInfo) {
+                            classMI[j] = conditionalInfo;
+                        }/*reset classMI*/
+                        /*moved due to C indexing from 0 rather than 1*/
+                        lastUsedFeature[j] += 1;
+
+                        #pragma omp atomic read
+                        bound = score;
+                    }/*while partial score not below score & not reached last feature*/
+
+                    if ((lastUsedFeature[j] == i) && (classMI[j] >= bound)) {
+                        #pragma omp critical (CMIMScore)
+                        {
+                            if (BETTER_CANDIDATE(classMI[j],j,score,currentHighestFeature)) {
+                                #pragma omp atomic write
+                                score = classMI[j];
+                                currentHighestFeature = j;
+                            }
+                        }/*raise the shared score*/
+                    }/*if the partial score is exact and may still win*/
+                }
+            }/*for number of features*/
+        }/*parallel scoring of the candidates*/
+
+        selectedFeatures[currentHighestFeature] = 1;
+        outputFeatures[i] = currentHighestFeature;
+        featureScores[i] = score;
     }/*for the number of features to select*/
 
     FREE_FUNC(classMI);
     FREE_FUNC(lastUsedFeature);
+    FREE_FUNC(selectedFeatures);
 
     classMI = NULL;
     lastUsedFeature = NULL;
+    selectedFeatures = NULL;
 
     return outputFeatures;
+}/*columnCMIM(uint,FSColumnSet*,uint[],double[],FSOptions*)*/
+
+uint* CMIMWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores, FSOptions *options) {
+    FSColumnSet set;
+
+    createColumnSet(noOfSamples, noOfFeatures, featureMatrix, classColumn, options, &set);
+
+    columnCMIM(k, &set, outputFeatures, featureScores, options);
+
+    freeColumnSet(&set);
+
+    return outputFeatures;
+}/*CMIMWithOptions(uint,uint,uint,uint[][],uint[],uint[],double[],FSOptions*)*/
+
+uint* CMIM(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores) {
+    return CMIMWithOptions(k, noOfSamples, noOfFeatures, featureMatrix, classColumn, outputFeatures, featureScores, NULL);
 }/*CMIM(uint,uint,uint,uint[][],uint[],uint[],double[])*/
 
+uint* datasetCMIM(uint k, FEASTDataset *dataset, uint *outputFeatures, double *featureScores, FSOptions *options) {
+    columnCMIM(searchLength(dataset,k), searchColumnSet(dataset), outputFeatures, featureScores, options);
+    return restoreFeatureIndices(dataset, k, outputFeatures, featureScores);
+}/*datasetCMIM(uint,FEASTDataset*,uint[],double[],FSOptions*)*/
+
 double* discCMIM(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *outputFeatures, double *featureScores) {
-    uint *intFeatures = (uint *) checkedCalloc(noOfSamples*noOfFeatures,sizeof(uint));
-    uint *intClass = (uint *) checkedCalloc(noOfSamples,sizeof(uint));
+    FSColumnSet set;
     uint *intOutputs = (uint *) checkedCalloc(k,sizeof(uint));
 
-    uint **intFeature2D = (uint**) checkedCalloc(noOfFeatures,sizeof(uint*));
-
     int i;
 
-    for (i = 0; i < noOfFeatures; i++) {
-        intFeature2D[i] = intFeatures + i*noOfSamples;
-        normaliseArray(featureMatrix[i],intFeature2D[i],noOfSamples);
-    }
-
-    normaliseArray(classColumn,intClass,noOfSamples);
+    normaliseColumnSet(noOfSamples, noOfFeatures, featureMatrix, classColumn, &set);
 
-    CMIM(k, noOfSamples, noOfFeatures, intFeature2D, intClass, intOutputs, featureScores);
+    columnCMIM(k, &set, intOutputs, featureScores, NULL);
 
     for (i = 0; i < k; i++) {
         outputFeatures[i] = intOutputs[i];
     }
 
-    FREE_FUNC(intFeatures);
-    FREE_FUNC(intClass);
+    freeColumnSet(&set);
     FREE_FUNC(intOutputs);
-    FREE_FUNC(intFeature2D);
 
-    intFeatures = NULL;
-    intClass = NULL;
     intOutputs = NULL;
-    intFeature2D = NULL;
 
     return outputFeatures;
 }/*discCMIM(int,int,int,double[][],double[],double[],featureScores)*/
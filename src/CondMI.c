@@ -6,6 +6,10 @@
 **           22/02/2014 - Patched calloc.
 **           12/03/2016 - Changed initial value of maxMI to -1.0 to prevent segfaults when I(X;Y) = 0.0 for all X.
 **           17/12/2016 - Added feature scores.
+**           17/10/2026 - Moved the class MI calculation into the shared parallel relevance pass.
+**           17/10/2026 - Split out a column variant which reads compact 8/16 bit columns.
+**           17/10/2026 - Added the bitmap index for the condition.
+**           17/10/2026 - Added the FEASTDataset entry point.
 **
 ** Author - Adam Pocock
 ** 
@@ -47,15 +51,18 @@
 
 #include "FEAST/FSAlgorithms.h"
 #include "FEAST/FSToolbox.h"
+#include "FSInternal.h"
 
-/* for memcpy */
+/* for memset */
 #include <string.h>
 
 /* MIToolbox includes */
 #include "MIToolbox/MutualInformation.h"
 #include "MIToolbox/ArrayOperations.h"
 
-int* CondMI(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, int *outputFeatures, double *featureScores) {
+int* columnCondMI(uint k, FSColumnSet *set, int *outputFeatures, double *featureScores, FSOptions *options) {
+    uint noOfSamples = set->noOfSamples;
+    uint noOfFeatures = set->noOfFeatures;
     char *selectedFeatures = (char *) checkedCalloc(noOfFeatures,sizeof(char));
 
     /*holds the class MI values*/
@@ -69,6 +76,13 @@ int* CondMI(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, u
     int currentHighestFeature;
 
     uint *conditionVector = (uint *) checkedCalloc(noOfSamples,sizeof(uint));
+    /*the selected feature is widened into here before merging it into the condition*/
+    uint *selectedVector = (uint *) checkedCalloc(noOfSamples,sizeof(uint));
+    FSColumn conditionColumn;
+    /*holds the bitmap index of the condition while it has few enough states*/
+    int useBitmap = (options != NULL) && options->bitmapIndex && (set->rowCounts == NULL);
+    int numWords = bitmapWords(noOfSamples);
+    FSWord *conditionBits = useBitmap ? (FSWord *) checkedCalloc(FS_BITMAP_MAX_STATES * numWords,sizeof(FSWord)) : NULL;
 
     int i, j;
 
@@ -76,12 +90,9 @@ int* CondMI(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, u
         outputFeatures[i] = -1;
     }
 
-    for (i = 0; i < noOfFeatures; i++) {
-        /*calculate mutual info
-         **double calcMutualInformation(uint *firstVector, uint *secondVector, int vectorLength);
-         */
-        classMI[i] = calcMutualInformation(featureMatrix[i], classColumn, noOfSamples);
+    calculateClassMI(set, classMI, options);
 
+    for (i = 0; i < noOfFeatures; i++) {
         if (classMI[i] > maxMI) {
             maxMI = classMI[i];
             maxMICounter = i;
@@ -92,7 +103,18 @@ int* CondMI(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, u
     outputFeatures[0] = maxMICounter;
     featureScores[0] = maxMI;
 
-    memcpy(conditionVector, featureMatrix[maxMICounter],sizeof(int)*noOfSamples);
+    unpackColumn(set->features + maxMICounter, noOfSamples, conditionVector);
+    conditionColumn.data = conditionVector;
+    conditionColumn.width = sizeof(uint);
+    conditionColumn.numStates = set->features[maxMICounter].numStates;
+    conditionColumn.bits = NULL;
+    conditionColumn.rowIndices = NULL;
+    conditionColumn.noOfEntries = noOfSamples;
+    conditionColumn.stateCounts = NULL;
+    conditionColumn.rowCounts = set->rowCounts;
+    if (useBitmap && (conditionColumn.numStates <= FS_BITMAP_MAX_STATES)) {
+        buildColumnBitmap(&conditionColumn, noOfSamples, conditionBits);
+    }
 
     /*****************************************************************************
      ** We have populated the classMI array, and selected the highest
@@ -110,8 +132,8 @@ int* CondMI(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, u
             if (selectedFeatures[j] == 0) {
                 currentScore = 0.0;
 
-                /*double calcConditionalMutualInformation(uint *firstVector, uint *targetVector, uint *conditionVector, int vectorLength);*/
-                currentScore = calcConditionalMutualInformation(featureMatrix[j], classColumn, conditionVector, noOfSamples);
+                /*JointStatistics calcJointStatistics(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn, int vectorLength);*/
+                currentScore = calcJointStatistics(&conditionColumn, set->features + j, &(set->classColumn), noOfSamples).classCMI;
 
                 if (currentScore > score) {
                     score = currentScore;
@@ -125,52 +147,73 @@ int* CondMI(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, u
 
         if (currentHighestFeature != -1) {
             selectedFeatures[currentHighestFeature] = 1;
-            mergeArrays(featureMatrix[currentHighestFeature], conditionVector, conditionVector, noOfSamples);
+            unpackColumn(set->features + currentHighestFeature, noOfSamples, selectedVector);
+            mergeArrays(selectedVector, conditionVector, conditionVector, noOfSamples);
+            conditionColumn.numStates = maxState(conditionVector, noOfSamples);
+            conditionColumn.bits = NULL;
+            if (useBitmap && (conditionColumn.numStates <= FS_BITMAP_MAX_STATES)) {
+                memset(conditionBits, 0, sizeof(FSWord) * FS_BITMAP_MAX_STATES * numWords);
+                buildColumnBitmap(&conditionColumn, noOfSamples, conditionBits);
+            }
         }
     }/*for the number of features to select*/
 
     FREE_FUNC(classMI);
     FREE_FUNC(conditionVector);
+    FREE_FUNC(selectedVector);
     FREE_FUNC(selectedFeatures);
+    if (conditionBits != NULL) {
+        FREE_FUNC(conditionBits);
+    }
 
     classMI = NULL;
     conditionVector = NULL;
+    selectedVector = NULL;
+    conditionBits = NULL;
     selectedFeatures = NULL;
 
     return outputFeatures;
+}/*columnCondMI(uint,FSColumnSet*,int[],double[],FSOptions*)*/
+
+int* CondMIWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, int *outputFeatures, double *featureScores, FSOptions *options) {
+    FSColumnSet set;
+
+    createColumnSet(noOfSamples, noOfFeatures, featureMatrix, classColumn, options, &set);
+
+    columnCondMI(k, &set, outputFeatures, featureScores, options);
+
+    freeColumnSet(&set);
+
+    return outputFeatures;
+}/*CondMIWithOptions(uint,uint,uint,uint[][],uint[],int[],double[],FSOptions*)*/
+
+int* CondMI(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, int *outputFeatures, double *featureScores) {
+    return CondMIWithOptions(k, noOfSamples, noOfFeatures, featureMatrix, classColumn, outputFeatures, featureScores, NULL);
 }/*CondMI(uint,uint,uint,uint[][],uint[],int[],double[])*/
 
+int* datasetCondMI(uint k, FEASTDataset *dataset, int *outputFeatures, double *featureScores, FSOptions *options) {
+    columnCondMI(searchLength(dataset,k), searchColumnSet(dataset), outputFeatures, featureScores, options);
+    return restoreConditionalIndices(dataset, k, outputFeatures, featureScores);
+}/*datasetCondMI(uint,FEASTDataset*,int[],double[],FSOptions*)*/
+
 double* discCondMI(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *outputFeatures, double *featureScores) {
-    uint *intFeatures = (uint *) checkedCalloc(noOfSamples*noOfFeatures,sizeof(uint));
-    uint *intClass = (uint *) checkedCalloc(noOfSamples,sizeof(uint));
+    FSColumnSet set;
     int *intOutputs = (int *) checkedCalloc(k,sizeof(int));
 
-    uint **intFeature2D = (uint**) checkedCalloc(noOfFeatures,sizeof(uint*));
-
     int i;
 
-    for (i = 0; i < noOfFeatures; i++) {
-        intFeature2D[i] = intFeatures + i*noOfSamples;
-        normaliseArray(featureMatrix[i],intFeature2D[i],noOfSamples);
-    }
-
-    normaliseArray(classColumn,intClass,noOfSamples);
+    normaliseColumnSet(noOfSamples, noOfFeatures, featureMatrix, classColumn, &set);
 
-    CondMI(k, noOfSamples, noOfFeatures, intFeature2D, intClass, intOutputs, featureScores);
+    columnCondMI(k, &set, intOutputs, featureScores, NULL);
 
     for (i = 0; i < k; i++) {
         outputFeatures[i] = intOutputs[i];
     }
 
-    FREE_FUNC(intFeatures);
-    FREE_FUNC(intClass);
+    freeColumnSet(&set);
     FREE_FUNC(intOutputs);
-    FREE_FUNC(intFeature2D);
 
-    intFeatures = NULL;
-    intClass = NULL;
     intOutputs = NULL;
-    intFeature2D = NULL;
 
     return outputFeatures;
 }/*discCondMI(int,int,int,double[][],double[],double[],double[])*/
@@ -11,6 +11,13 @@
 **           22/02/2014 - Patched calloc.
 **           12/03/2016 - Changed initial value of maxMI to -1.0 to prevent segfaults when I(X;Y) = 0.0 for all X.
 **           17/12/2016 - Added feature scores.
+**           17/10/2026 - Added multi-threaded candidate scoring.
+**           17/10/2026 - Moved the class MI calculation into the shared parallel relevance pass.
+**           17/10/2026 - Replaced the k*noOfFeatures MI cache with a running score per feature.
+**           17/10/2026 - Switched the pairwise terms to the fused joint statistics kernel.
+**           17/10/2026 - Split out a column variant which reads compact 8/16 bit columns.
+**           17/10/2026 - Added the FEASTDataset entry point.
+**           17/10/2026 - Added lazy evaluation using a heap of candidates keyed by an upper bound on their score.
 **
 ** Author - Adam Pocock
 ** 
@@ -52,46 +59,51 @@
 
 #include "FEAST/FSAlgorithms.h"
 #include "FEAST/FSToolbox.h"
+#include "FSInternal.h"
 
 /* MIToolbox includes */
 #include "MIToolbox/MutualInformation.h"
-#include "MIToolbox/Entropy.h"
 #include "MIToolbox/ArrayOperations.h"
 
-uint* DISR(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores) {
+uint* columnDISR(uint k, FSColumnSet *set, uint *outputFeatures, double *featureScores, FSOptions *options) {
+    uint noOfSamples = set->noOfSamples;
+    uint noOfFeatures = set->noOfFeatures;
     char *selectedFeatures = (char *) checkedCalloc(noOfFeatures,sizeof(char));
 
     /*holds the class MI values*/
     double *classMI = (double *) checkedCalloc(noOfFeatures,sizeof(double));
 
-    /*holds the intra feature MI values*/
-    int sizeOfMatrix = k*noOfFeatures;
-    double *featureMIMatrix = (double *) checkedCalloc(sizeOfMatrix,sizeof(double));
+    /*holds the DISR score of each feature, which gains one term per iteration*/
+    double *runningScores = (double *) checkedCalloc(noOfFeatures,sizeof(double));
 
     /*Changed to ensure it always picks a feature*/
     double maxMI = -1.0;
     int maxMICounter = -1;
 
-    double score, currentScore;
+    double score;
     int currentHighestFeature;
 
-    uint *mergedVector = (uint *) checkedCalloc(noOfSamples,sizeof(uint));
+    int numThreads = numberOfThreads(options);
 
-    int arrayPosition;
-    double mi, tripEntropy;
+    /*lazy evaluation keeps the candidates in a heap keyed by an upper bound on their score*/
+    int lazy = (options != NULL) && options->lazyEvaluation;
+    /*each term I(X_m,X_j;Y)/H(X_m,X_j,Y) is at most 1, and at most (I(X_m;Y) + H(X_j))/H(X_m,Y)*/
+    double termBound = 0.0;
+    double slack, termLimit, jointEntropyBound;
+    /*holds H(X_j) for each feature, and H(Y) in position noOfFeatures*/
+    double *entropies = NULL;
+    /*the number of selected features whose terms are in each running score*/
+    uint *lastUsedFeature = NULL;
+    /*an upper bound on the score of each feature*/
+    double *upperBounds = NULL;
+    FSHeap candidateHeap;
+    JointStatistics stats;
 
-    int i, j, x;
+    int i, j;
 
-    for (i = 0; i < sizeOfMatrix; i++) {
-        featureMIMatrix[i] = -1;
-    }/*for featureMIMatrix - blank to -1*/
+    calculateClassMI(set, classMI, options);
 
     for (i = 0; i < noOfFeatures; i++) {
-        /*calculate mutual info
-         **double calcMutualInformation(uint *firstVector, uint *secondVector, int vectorLength);
-         */
-        classMI[i] = calcMutualInformation(featureMatrix[i], classColumn, noOfSamples);
-
         if (classMI[i] > maxMI) {
             maxMI = classMI[i];
             maxMICounter = i;
@@ -102,6 +114,15 @@ uint* DISR(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, ui
     outputFeatures[0] = maxMICounter;
     featureScores[0] = maxMI;
 
+    if (lazy) {
+        entropies = (double *) checkedCalloc(noOfFeatures+1,sizeof(double));
+        calculateEntropies(set, entropies, options);
+        termBound = 1.0;
+        lastUsedFeature = (uint *) checkedCalloc(noOfFeatures,sizeof(uint));
+        upperBounds = (double *) checkedCalloc(noOfFeatures,sizeof(double));
+        createHeap(noOfFeatures, &candidateHeap);
+    }
+
     /*****************************************************************************
      ** We have populated the classMI array, and selected the highest
      ** MI feature as the first output feature
@@ -111,36 +132,79 @@ uint* DISR(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, ui
     for (i = 1; i < k; i++) {
         score = 0.0;
         currentHighestFeature = 0;
-        currentScore = 0.0;
-
-        for (j = 0; j < noOfFeatures; j++) {
-            /*if we haven't selected j*/
-            if (selectedFeatures[j] == 0) {
-                currentScore = 0.0;
-
-                for (x = 0; x < i; x++) {
-                    arrayPosition = x * noOfFeatures + j;
-                    if (featureMIMatrix[arrayPosition] == -1) {
-                        /*
-                         **double calcMutualInformation(uint *firstVector, uint *secondVector, int vectorLength);
-                         **double calcJointEntropy(uint *firstVector, uint *secondVector, int vectorLength);
-                         */
-
-                        mergeArrays(featureMatrix[outputFeatures[x]], featureMatrix[j], mergedVector, noOfSamples);
-                        mi = calcMutualInformation(mergedVector, classColumn, noOfSamples);
-                        tripEntropy = calcJointEntropy(mergedVector, classColumn, noOfSamples);
-
-                        featureMIMatrix[arrayPosition] = mi / tripEntropy;
-                    }/*if not already known*/
-                    currentScore += featureMIMatrix[arrayPosition];
-                }/*for the number of already selected features*/
-
-                if (currentScore > score) {
-                    score = currentScore;
+
+        if (lazy) {
+            /*H(X_m,X_j,Y) is at least H(X_m,Y) = H(X_m) + H(Y) - I(X_m;Y)*/
+            jointEntropyBound = entropies[outputFeatures[i-1]] + entropies[noOfFeatures] - classMI[outputFeatures[i-1]];
+
+            /*add the bound on the newest term to each candidate, then heap them by bound*/
+            slack = FS_BOUND_TOLERANCE * (1.0 + i * termBound);
+            candidateHeap.size = 0;
+
+            for (j = 0; j < noOfFeatures; j++) {
+                if (!selectedFeatures[j]) {
+                    termLimit = (jointEntropyBound > 0.0) ? (classMI[outputFeatures[i-1]] + entropies[j]) / jointEntropyBound : termBound;
+                    upperBounds[j] += (termLimit < termBound) ? termLimit : termBound;
+                    candidateHeap.keys[candidateHeap.size] = upperBounds[j];
+                    candidateHeap.indices[candidateHeap.size] = j;
+                    candidateHeap.size++;
+                }
+            }
+            /*every bound changed, so the heap is rebuilt rather than updated*/
+            buildHeap(&candidateHeap);
+
+            while ((candidateHeap.size > 0) && ((candidateHeap.keys[0] + slack) >= score)) {
+                j = popHeap(&candidateHeap);
+
+                while (lastUsedFeature[j] < i) {
+                    /*JointStatistics calcJointStatistics(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn, int vectorLength);*/
+                    stats = calcJointStatistics(set->features + outputFeatures[lastUsedFeature[j]], set->features + j, &(set->classColumn), noOfSamples);
+                    runningScores[j] += stats.jointMI / stats.jointEntropy;
+                    lastUsedFeature[j] += 1;
+                }/*while terms are missing*/
+
+                /*the score is now exact*/
+                upperBounds[j] = runningScores[j];
+
+                if (BETTER_CANDIDATE(runningScores[j],j,score,currentHighestFeature)) {
+                    score = runningScores[j];
                     currentHighestFeature = j;
                 }
-            }/*if j is unselected*/
-        }/*for number of features*/
+            }/*while the top candidate may still win*/
+        } else {
+            #pragma omp parallel num_threads(numThreads) if (numThreads > 1)
+            {
+                double threadScore = 0.0;
+                int threadHighestFeature = 0;
+                JointStatistics stats;
+                int j;
+
+                #pragma omp for schedule(dynamic,FS_CHUNK_SIZE)
+                for (j = 0; j < noOfFeatures; j++) {
+                    /*if we haven't selected j*/
+                    if (selectedFeatures[j] == 0) {
+                        /*only the term for the last selected feature is new*/
+                        /*JointStatistics calcJointStatistics(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn, int vectorLength);*/
+                        stats = calcJointStatistics(set->features + outputFeatures[i-1], set->features + j, &(set->classColumn), noOfSamples);
+
+                        runningScores[j] += stats.jointMI / stats.jointEntropy;
+
+                        if (BETTER_CANDIDATE(runningScores[j],j,threadScore,threadHighestFeature)) {
+                            threadScore = runningScores[j];
+                            threadHighestFeature = j;
+                        }
+                    }/*if j is unselected*/
+                }/*for number of features*/
+
+                #pragma omp critical (DISRReduce)
+                {
+                    if (BETTER_CANDIDATE(threadScore,threadHighestFeature,score,currentHighestFeature)) {
+                        score = threadScore;
+                        currentHighestFeature = threadHighestFeature;
+                    }
+                }/*reduce the thread maxima*/
+            }/*parallel scoring of the candidates*/
+        }
 
         selectedFeatures[currentHighestFeature] = 1;
         outputFeatures[i] = currentHighestFeature;
@@ -149,49 +213,65 @@ uint* DISR(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, ui
     }/*for the number of features to select*/
 
     FREE_FUNC(classMI);
-    FREE_FUNC(mergedVector);
-    FREE_FUNC(featureMIMatrix);
+    FREE_FUNC(runningScores);
     FREE_FUNC(selectedFeatures);
 
+    if (lazy) {
+        FREE_FUNC(entropies);
+        FREE_FUNC(lastUsedFeature);
+        FREE_FUNC(upperBounds);
+        freeHeap(&candidateHeap);
+        entropies = NULL;
+        lastUsedFeature = NULL;
+        upperBounds = NULL;
+    }
+
     classMI = NULL;
-    mergedVector = NULL;
-    featureMIMatrix = NULL;
+    runningScores = NULL;
     selectedFeatures = NULL;
 
     return outputFeatures;
+}/*columnDISR(uint,FSColumnSet*,uint[],double[],FSOptions*)*/
+
+uint* DISRWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores, FSOptions *options) {
+    FSColumnSet set;
+
+    createColumnSet(noOfSamples, noOfFeatures, featureMatrix, classColumn, options, &set);
+
+    columnDISR(k, &set, outputFeatures, featureScores, options);
+
+    freeColumnSet(&set);
+
+    return outputFeatures;
+}/*DISRWithOptions(uint,uint,uint,uint[][],uint[],uint[],double[],FSOptions*)*/
+
+uint* DISR(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores) {
+    return DISRWithOptions(k, noOfSamples, noOfFeatures, featureMatrix, classColumn, outputFeatures, featureScores, NULL);
 }/*DISR(uint,uint,uint,uint[][],uint[],uint[],double[])*/
 
+uint* datasetDISR(uint k, FEASTDataset *dataset, uint *outputFeatures, double *featureScores, FSOptions *options) {
+    columnDISR(searchLength(dataset,k), searchColumnSet(dataset), outputFeatures, featureScores, options);
+    return restoreFeatureIndices(dataset, k, outputFeatures, featureScores);
+}/*datasetDISR(uint,FEASTDataset*,uint[],double[],FSOptions*)*/
+
 double* discDISR(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *outputFeatures, double *featureScores) {
-    uint *intFeatures = (uint *) checkedCalloc(noOfSamples*noOfFeatures,sizeof(uint));
-    uint *intClass = (uint *) checkedCalloc(noOfSamples,sizeof(uint));
+    FSColumnSet set;
     uint *intOutputs = (uint *) checkedCalloc(k,sizeof(uint));
 
-    uint **intFeature2D = (uint**) checkedCalloc(noOfFeatures,sizeof(uint*));
-
     int i;
 
-    for (i = 0; i < noOfFeatures; i++) {
-        intFeature2D[i] = intFeatures + i*noOfSamples;
-        normaliseArray(featureMatrix[i],intFeature2D[i],noOfSamples);
-    }
-
-    normaliseArray(classColumn,intClass,noOfSamples);
+    normaliseColumnSet(noOfSamples, noOfFeatures, featureMatrix, classColumn, &set);
 
-    DISR(k, noOfSamples, noOfFeatures, intFeature2D, intClass, intOutputs, featureScores);
+    columnDISR(k, &set, intOutputs, featureScores, NULL);
 
     for (i = 0; i < k; i++) {
         outputFeatures[i] = intOutputs[i];
     }
 
-    FREE_FUNC(intFeatures);
-    FREE_FUNC(intClass);
+    freeColumnSet(&set);
     FREE_FUNC(intOutputs);
-    FREE_FUNC(intFeature2D);
 
-    intFeatures = NULL;
-    intClass = NULL;
     intOutputs = NULL;
-    intFeature2D = NULL;
 
     return outputFeatures;
 }/*discDISR(int,int,int,double[][],double[],double[],double[])*/
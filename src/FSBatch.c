@@ -0,0 +1,528 @@
+/*******************************************************************************
+** FSBatch.c
+** Implements batchFeatureSelection(). Each criterion runs its own forward
+** search, but the terms between a selected feature and every candidate are
+** calculated once with calcJointStatistics() and kept, so the criteria share
+** the work for every feature they have in common.
+**
+** Author: Adam Pocock
+** Created: 17/10/2026
+**
+** Part of the FEAture Selection Toolbox (FEAST), please reference
+** "Conditional Likelihood Maximisation: A Unifying Framework for Information
+** Theoretic Feature Selection"
+** G. Brown, A. Pocock, M.-J. Zhao, M. Lujan
+** Journal of Machine Learning Research (JMLR), 2012
+**
+** Please check www.github.com/Craigacp/FEAST for updates.
+** 
+** Copyright (c) 2010-2017, A. Pocock, G. Brown, The University of Manchester
+** All rights reserved.
+** 
+** Redistribution and use in source and binary forms, with or without modification,
+** are permitted provided that the following conditions are met:
+** 
+**   - Redistributions of source code must retain the above copyright notice, this 
+**     list of conditions and the following disclaimer.
+**   - Redistributions in binary form must reproduce the above copyright notice, 
+**     this list of conditions and the following disclaimer in the documentation 
+**     and/or other materials provided with the distribution.
+**   - Neither the name of The University of Manchester nor the names of its 
+**     contributors may be used to endorse or promote products derived from this 
+**     software without specific prior written permission.
+** 
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+** ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+** ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+** (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+** LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+** ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+** SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+*******************************************************************************/
+
+
+#include "FEAST/FSBatch.h"
+#include "FEAST/FSToolbox.h"
+#include "FSInternal.h"
+
+/* for memcpy */
+#include <string.h>
+
+/*******************************************************************************
+** BatchSource is what columnPairRow() needs to calculate the rows of the
+** cache from a column set.
+*******************************************************************************/
+typedef struct BatchSource {
+    FSColumnSet *set;
+    FSOptions *options;
+} BatchSource;
+
+/*******************************************************************************
+** columnPairRow() returns the cached terms between feature m and every
+** feature, calculating them in parallel the first time m is asked for.
+*******************************************************************************/
+static double* columnPairRow(void *source, FSPairCache *cache, uint m) {
+    FSColumnSet *set = ((BatchSource *) source)->set;
+    int numThreads = numberOfThreads(((BatchSource *) source)->options);
+    double *row;
+    int j;
+
+    if (cache->rows[m] == NULL) {
+        row = (double *) checkedCalloc((size_t) cache->noOfFields * set->noOfFeatures,sizeof(double));
+
+        #pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(dynamic,FS_CHUNK_SIZE)
+        for (j = 0; j < set->noOfFeatures; j++) {
+            if (j != m) {
+                JointStatistics stats;
+                if (cache->jointFields > 0) {
+                    /*JointStatistics calcJointStatistics(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn, int vectorLength);*/
+                    stats = calcJointStatistics(set->features + m, set->features + j, &(set->classColumn), set->noOfSamples);
+                    storePairStatistics(cache, row, j, &stats);
+                }
+                if (cache->fieldOffsets[FS_PAIR_COLUMN_MI] != -1) {
+                    /*double calcColumnMI(FSColumn *firstColumn, FSColumn *secondColumn, int vectorLength);*/
+                    PAIR_TERM(cache,row,FS_PAIR_COLUMN_MI,j) = calcColumnMI(set->features + m, set->features + j, set->noOfSamples);
+                }
+            }
+        }/*for noOfFeatures - filling the row*/
+
+        cache->rows[m] = row;
+    }
+
+    return cache->rows[m];
+}/*columnPairRow(void*,FSPairCache*,uint)*/
+
+void createPairCache(uint noOfFeatures, uint noOfCriteria, FSCriterion *criteria, FSPairCache *cache) {
+    int used[FS_PAIR_FIELDS];
+    int field;
+    uint c;
+
+    for (field = 0; field < FS_PAIR_FIELDS; field++) {
+        used[field] = 0;
+    }
+
+    for (c = 0; c < noOfCriteria; c++) {
+        switch (criteria[c].criterion) {
+            case FS_MRMR_D:
+                used[FS_PAIR_COLUMN_MI] = 1;
+                break;
+            case FS_CMIM:
+                used[FS_PAIR_CLASS_CMI] = 1;
+                break;
+            case FS_JMI:
+                used[FS_PAIR_JOINT_MI] = 1;
+                break;
+            case FS_DISR:
+                used[FS_PAIR_JOINT_MI] = 1;
+                used[FS_PAIR_JOINT_ENTROPY] = 1;
+                break;
+            case FS_ICAP:
+            case FS_BETAGAMMA:
+                used[FS_PAIR_MI] = 1;
+                used[FS_PAIR_CMI] = 1;
+                break;
+            default:
+                /*MIM and CondMI don't read the pairwise terms*/
+                break;
+        }
+    }
+
+    cache->noOfFeatures = noOfFeatures;
+    cache->noOfFields = 0;
+    for (field = 0; field < FS_PAIR_FIELDS; field++) {
+        cache->fieldOffsets[field] = used[field] ? cache->noOfFields++ : -1;
+    }
+    cache->jointFields = cache->noOfFields - used[FS_PAIR_COLUMN_MI];
+    cache->rows = (double **) checkedCalloc(noOfFeatures + 1,sizeof(double *));
+}/*createPairCache(uint,uint,FSCriterion[],FSPairCache*)*/
+
+void storePairStatistics(FSPairCache *cache, double *row, uint j, JointStatistics *stats) {
+    if (cache->fieldOffsets[FS_PAIR_MI] != -1) {
+        PAIR_TERM(cache,row,FS_PAIR_MI,j) = stats->mi;
+    }
+    if (cache->fieldOffsets[FS_PAIR_CMI] != -1) {
+        PAIR_TERM(cache,row,FS_PAIR_CMI,j) = stats->cmi;
+    }
+    if (cache->fieldOffsets[FS_PAIR_JOINT_MI] != -1) {
+        PAIR_TERM(cache,row,FS_PAIR_JOINT_MI,j) = stats->jointMI;
+    }
+    if (cache->fieldOffsets[FS_PAIR_CLASS_CMI] != -1) {
+        PAIR_TERM(cache,row,FS_PAIR_CLASS_CMI,j) = stats->classCMI;
+    }
+    if (cache->fieldOffsets[FS_PAIR_JOINT_ENTROPY] != -1) {
+        PAIR_TERM(cache,row,FS_PAIR_JOINT_ENTROPY,j) = stats->jointEntropy;
+    }
+}/*storePairStatistics(FSPairCache*,double[],uint,JointStatistics*)*/
+
+void freePairCache(FSPairCache *cache) {
+    uint i;
+
+    for (i = 0; i < cache->noOfFeatures; i++) {
+        if (cache->rows[i] != NULL) {
+            FREE_FUNC(cache->rows[i]);
+            cache->rows[i] = NULL;
+        }
+    }
+
+    FREE_FUNC(cache->rows);
+    cache->rows = NULL;
+}/*freePairCache(FSPairCache*)*/
+
+void startingCandidate(int criterion, double *score, int *index) {
+    switch (criterion) {
+        case FS_MIM:
+        case FS_CMIM:
+            *score = -1.0;
+            *index = 0;
+            break;
+        case FS_CONDMI:
+            *score = 0.0;
+            *index = -1;
+            break;
+        case FS_JMI:
+        case FS_DISR:
+            *score = 0.0;
+            *index = 0;
+            break;
+        default:
+            *score = -DBL_MAX;
+            *index = 0;
+            break;
+    }
+}/*startingCandidate(int,double*,int*)*/
+
+double startingRunningScore(int criterion, double classMI) {
+    return ((criterion == FS_ICAP) || (criterion == FS_CMIM)) ? classMI : 0.0;
+}/*startingRunningScore(int,double)*/
+
+double criterionTerm(FSCriterion *criterion, JointStatistics *stats) {
+    double term;
+
+    switch (criterion->criterion) {
+        case FS_MRMR_D:
+            term = stats->mi;
+            break;
+        case FS_CMIM:
+        case FS_CONDMI:
+            term = stats->classCMI;
+            break;
+        case FS_JMI:
+            term = stats->jointMI;
+            break;
+        case FS_DISR:
+            term = stats->jointMI / stats->jointEntropy;
+            break;
+        case FS_ICAP:
+            term = stats->cmi - stats->mi;
+            break;
+        case FS_BETAGAMMA:
+            term = criterion->betaParam * stats->mi;
+            term -= criterion->gammaParam * stats->cmi;
+            break;
+        default:
+            term = 0.0;
+            break;
+    }
+
+    return term;
+}/*criterionTerm(FSCriterion*,JointStatistics*)*/
+
+double scoreCandidate(FSCriterion *criterion, double term, double classMI, uint round, double *runningScore) {
+    double currentScore;
+
+    switch (criterion->criterion) {
+        case FS_MIM:
+            currentScore = classMI;
+            break;
+        case FS_MRMR_D:
+            *runningScore += term;
+            currentScore = classMI;
+            currentScore -= (*runningScore / round);
+            break;
+        case FS_CMIM:
+            if (*runningScore > term) {
+                *runningScore = term;
+            }
+            currentScore = *runningScore;
+            break;
+        case FS_CONDMI:
+            currentScore = term;
+            break;
+        case FS_ICAP:
+            if (term < 0) {
+                *runningScore += term;
+            }
+            currentScore = *runningScore;
+            break;
+        case FS_BETAGAMMA:
+            *runningScore += term;
+            currentScore = classMI;
+            currentScore -= (*runningScore);
+            break;
+        default:
+            /*JMI and DISR sum their terms*/
+            *runningScore += term;
+            currentScore = *runningScore;
+            break;
+    }
+
+    return currentScore;
+}/*scoreCandidate(FSCriterion*,double,double,uint,double*)*/
+
+/*******************************************************************************
+** cachedTerm() returns criterionTerm() for the selected feature of row and
+** candidate j, from the fields of the row.
+*******************************************************************************/
+static double cachedTerm(FSPairCache *cache, double *row, uint j, FSCriterion *criterion) {
+    JointStatistics stats;
+
+    if (criterion->criterion == FS_MRMR_D) {
+        return PAIR_TERM(cache,row,FS_PAIR_COLUMN_MI,j);
+    }
+
+    stats.mi = cache->fieldOffsets[FS_PAIR_MI] != -1 ? PAIR_TERM(cache,row,FS_PAIR_MI,j) : 0.0;
+    stats.cmi = cache->fieldOffsets[FS_PAIR_CMI] != -1 ? PAIR_TERM(cache,row,FS_PAIR_CMI,j) : 0.0;
+    stats.jointMI = cache->fieldOffsets[FS_PAIR_JOINT_MI] != -1 ? PAIR_TERM(cache,row,FS_PAIR_JOINT_MI,j) : 0.0;
+    stats.classCMI = cache->fieldOffsets[FS_PAIR_CLASS_CMI] != -1 ? PAIR_TERM(cache,row,FS_PAIR_CLASS_CMI,j) : 0.0;
+    stats.jointEntropy = cache->fieldOffsets[FS_PAIR_JOINT_ENTROPY] != -1 ? PAIR_TERM(cache,row,FS_PAIR_JOINT_ENTROPY,j) : 0.0;
+
+    /*double criterionTerm(FSCriterion *criterion, JointStatistics *stats);*/
+    return criterionTerm(criterion, &stats);
+}/*cachedTerm(FSPairCache*,double[],uint,FSCriterion*)*/
+
+void batchSearch(uint k, uint noOfFeatures, double *classMI, FSPairCache *cache, FSPairRowFunction pairRow, void *source, FSCriterion *criterion, uint *outputFeatures, double *featureScores) {
+    char *selectedFeatures = (char *) checkedCalloc(noOfFeatures,sizeof(char));
+
+    /*the running sum (or minimum for CMIM) of each feature's terms*/
+    double *runningScores = (double *) checkedCalloc(noOfFeatures,sizeof(double));
+
+    /*Changed to ensure it always picks a feature*/
+    double maxMI = -1.0;
+    int maxMICounter = -1;
+
+    double score, currentScore, term = 0.0;
+    int currentHighestFeature;
+    double *row = NULL;
+
+    int i, j;
+
+    for (i = 0; i < noOfFeatures; i++) {
+        runningScores[i] = startingRunningScore(criterion->criterion, classMI[i]);
+        if (classMI[i] > maxMI) {
+            maxMI = classMI[i];
+            maxMICounter = i;
+        }/*if bigger than current maximum*/
+    }/*for noOfFeatures - finding the most relevant feature*/
+
+    selectedFeatures[maxMICounter] = 1;
+    outputFeatures[0] = maxMICounter;
+    featureScores[0] = maxMI;
+
+    for (i = 1; i < k; i++) {
+        if (criterion->criterion != FS_MIM) {
+            row = pairRow(source, cache, outputFeatures[i-1]);
+        }
+
+        startingCandidate(criterion->criterion, &score, &currentHighestFeature);
+
+        for (j = 0; j < noOfFeatures; j++) {
+            /*if we haven't selected j*/
+            if (!selectedFeatures[j]) {
+                if (criterion->criterion != FS_MIM) {
+                    term = cachedTerm(cache, row, j, criterion);
+                }
+                currentScore = scoreCandidate(criterion, term, classMI[j], i, runningScores + j);
+
+                if (BETTER_CANDIDATE(currentScore,j,score,currentHighestFeature)) {
+                    score = currentScore;
+                    currentHighestFeature = j;
+                }
+            }/*if j is unselected*/
+        }/*for number of features*/
+
+        selectedFeatures[currentHighestFeature] = 1;
+        outputFeatures[i] = currentHighestFeature;
+        featureScores[i] = score;
+    }/*for the number of features to select*/
+
+    FREE_FUNC(runningScores);
+    FREE_FUNC(selectedFeatures);
+
+    runningScores = NULL;
+    selectedFeatures = NULL;
+}/*batchSearch(uint,uint,double[],FSPairCache*,FSPairRowFunction,void*,FSCriterion*,uint[],double[])*/
+
+/*******************************************************************************
+** productFitsInInt() returns 1 if first * second is at most INT_MAX, dividing
+** rather than multiplying so it can't overflow even where size_t is 32 bits.
+*******************************************************************************/
+static int productFitsInInt(uint first, uint second) {
+    return (first == 0) || (second <= INT_MAX / first);
+}/*productFitsInInt(uint,uint)*/
+
+/*******************************************************************************
+** tablesFitInInt() checks every table the criterion builds is indexed by an
+** int. The pairwise tables are indexed by the product of two features'
+** states, and CondMI's condition can grow to as many states as there are
+** samples. The joint counts have a cell per observed pair and class.
+*******************************************************************************/
+static int tablesFitInInt(int criterion, uint noOfSamples, uint largestNumStates, uint secondNumStates, uint classNumStates) {
+    uint firstNumStates = largestNumStates;
+    uint pairStates;
+
+    if ((criterion == FS_CONDMI) && (noOfSamples > firstNumStates)) {
+        firstNumStates = noOfSamples;
+        secondNumStates = largestNumStates;
+    }
+
+    if (!productFitsInInt(firstNumStates, secondNumStates) || !productFitsInInt(firstNumStates, classNumStates)) {
+        return 0;
+    }
+
+    /*a pair which is never observed has no cell*/
+    pairStates = firstNumStates * secondNumStates;
+    if (pairStates > noOfSamples) {
+        pairStates = noOfSamples;
+    }
+
+    return productFitsInInt(pairStates, classNumStates);
+}/*tablesFitInInt(int,uint,uint,uint,uint)*/
+
+int checkedFeatureSelection(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, FSCriterion *criterion, uint *outputFeatures, double *featureScores, FSOptions *options) {
+    FSColumnSet set;
+    int status;
+    uint largestNumStates = 0, secondNumStates = 1, classNumStates = 0, numStates;
+    uint i, j;
+
+    if ((criterion == NULL) || (criterion->criterion < FS_MIM) || (criterion->criterion > FS_BETAGAMMA)
+        || (featureMatrix == NULL) || (classColumn == NULL) || (outputFeatures == NULL) || (featureScores == NULL)
+        || (noOfSamples == 0) || (noOfSamples > INT_MAX) || (noOfFeatures > INT_MAX) || (k > noOfFeatures)) {
+        return FS_ERROR_ARGUMENT;
+    }
+
+    for (i = 0; i < noOfFeatures; i++) {
+        if (featureMatrix[i] == NULL) {
+            return FS_ERROR_ARGUMENT;
+        }
+    }
+
+    for (j = 0; j < noOfSamples; j++) {
+        if (classColumn[j] >= INT_MAX) {
+            return FS_ERROR_STATES;
+        }
+        if (classColumn[j] >= classNumStates) {
+            classNumStates = classColumn[j] + 1;
+        }
+    }
+
+    for (i = 0; i < noOfFeatures; i++) {
+        numStates = 0;
+        for (j = 0; j < noOfSamples; j++) {
+            if (featureMatrix[i][j] >= INT_MAX) {
+                return FS_ERROR_STATES;
+            }
+            if (featureMatrix[i][j] >= numStates) {
+                numStates = featureMatrix[i][j] + 1;
+            }
+        }
+        /*the pairwise tables are sized by the two features with the most states*/
+        if (numStates > largestNumStates) {
+            secondNumStates = largestNumStates > 0 ? largestNumStates : 1;
+            largestNumStates = numStates;
+        } else if (numStates > secondNumStates) {
+            secondNumStates = numStates;
+        }
+    }
+
+    if (!tablesFitInInt(criterion->criterion, noOfSamples, largestNumStates, secondNumStates, classNumStates)) {
+        return FS_ERROR_STATES;
+    }
+
+    if (k == 0) {
+        return FS_OK;
+    }
+
+    /*int tryCreateColumnSet(uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, FSOptions *options, FSColumnSet *set);*/
+    if (tryCreateColumnSet(noOfSamples, noOfFeatures, featureMatrix, classColumn, options, &set) != FS_OK) {
+        return FS_ERROR_MEMORY;
+    }
+
+    /*int checkedSearch(uint k, FSColumnSet *set, FSCriterion *criterion, uint *outputFeatures, double *featureScores, int numThreads);*/
+    status = checkedSearch(k, &set, criterion, outputFeatures, featureScores, numberOfThreads(options));
+
+    freeColumnSet(&set);
+
+    return status;
+}/*checkedFeatureSelection(uint,uint,uint,uint[][],uint[],FSCriterion*,uint[],double[],FSOptions*)*/
+
+void batchFeatureSelection(uint k, FEASTDataset *dataset, uint noOfCriteria, FSCriterion *criteria, uint **outputFeatures, double **featureScores, FSOptions *options) {
+    FSColumnSet *set = searchColumnSet(dataset);
+    uint searched = searchLength(dataset, k);
+
+    /*holds the class MI values, shared by every criterion*/
+    double *classMI = (double *) checkedCalloc(set->noOfFeatures,sizeof(double));
+
+    /*holds the terms between each selected feature and every feature*/
+    FSPairCache cache;
+
+    BatchSource source;
+    int *condMIOutputs;
+    uint i, c;
+
+    source.set = set;
+    source.options = options;
+
+    calculateClassMI(set, classMI, options);
+    createPairCache(set->noOfFeatures, noOfCriteria, criteria, &cache);
+
+    for (c = 0; c < noOfCriteria; c++) {
+        if (criteria[c].criterion == FS_CONDMI) {
+            /*the condition is the joint state of every selected feature, which isn't a pairwise term*/
+            condMIOutputs = (int *) checkedCalloc(k,sizeof(int));
+            columnCondMI(searched, set, condMIOutputs, featureScores[c], options);
+            restoreConditionalIndices(dataset, k, condMIOutputs, featureScores[c]);
+            for (i = 0; i < k; i++) {
+                outputFeatures[c][i] = (uint) condMIOutputs[i];
+            }
+            FREE_FUNC(condMIOutputs);
+            condMIOutputs = NULL;
+        } else {
+            batchSearch(searched, set->noOfFeatures, classMI, &cache, columnPairRow, &source, criteria + c, outputFeatures[c], featureScores[c]);
+            restoreFeatureIndices(dataset, k, outputFeatures[c], featureScores[c]);
+        }
+    }/*for each criterion*/
+
+    freePairCache(&cache);
+    FREE_FUNC(classMI);
+    classMI = NULL;
+}/*batchFeatureSelection(uint,FEASTDataset*,uint,FSCriterion[],uint[][],double[][],FSOptions*)*/
+
+void betaGammaSweep(uint k, FEASTDataset *dataset, uint noOfPairs, double *betaParams, double *gammaParams, uint **outputFeatures, double **featureScores, FSOptions *options) {
+    FSCriterion *criteria = (FSCriterion *) checkedCalloc(noOfPairs,sizeof(FSCriterion));
+    uint i;
+
+    for (i = 0; i < noOfPairs; i++) {
+        criteria[i].criterion = FS_BETAGAMMA;
+        criteria[i].betaParam = betaParams[i];
+        criteria[i].gammaParam = gammaParams[i];
+    }
+
+    /*the cached rows hold the raw MI and CMI, so every grid point shares them*/
+    batchFeatureSelection(k, dataset, noOfPairs, criteria, outputFeatures, featureScores, options);
+
+    FREE_FUNC(criteria);
+    criteria = NULL;
+}/*betaGammaSweep(uint,FEASTDataset*,uint,double[],double[],uint[][],double[][],FSOptions*)*/
+
+void BetaGammaSweep(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint noOfPairs, double *betaParams, double *gammaParams, uint **outputFeatures, double **featureScores, FSOptions *options) {
+    FEASTDataset *dataset = createFEASTDataset(noOfSamples, noOfFeatures, featureMatrix, classColumn, options);
+
+    betaGammaSweep(k, dataset, noOfPairs, betaParams, gammaParams, outputFeatures, featureScores, options);
+
+    freeFEASTDataset(dataset);
+    dataset = NULL;
+}/*BetaGammaSweep(uint,uint,uint,uint[][],uint[],uint,double[],double[],uint[][],double[][],FSOptions*)*/
@@ -0,0 +1,222 @@
+/*******************************************************************************
+** FSBitmap.c
+** Implements the bitmap index for columns with few states. Each state of a
+** column has a bitset over the samples, and the joint counts of three columns
+** are found by ANDing their bitsets and counting the set bits, which touches
+** 64 samples per operation on LP64 platforms.
+**
+** Author: Adam Pocock
+** Created: 17/10/2026
+**
+** Part of the FEAture Selection Toolbox (FEAST), please reference
+** "Conditional Likelihood Maximisation: A Unifying Framework for Information
+** Theoretic Feature Selection"
+** G. Brown, A. Pocock, M.-J. Zhao, M. Lujan
+** Journal of Machine Learning Research (JMLR), 2012
+**
+** Please check www.github.com/Craigacp/FEAST for updates.
+** 
+** Copyright (c) 2010-2017, A. Pocock, G. Brown, The University of Manchester
+** All rights reserved.
+** 
+** Redistribution and use in source and binary forms, with or without modification,
+** are permitted provided that the following conditions are met:
+** 
+**   - Redistributions of source code must retain the above copyright notice, this 
+**     list of conditions and the following disclaimer.
+**   - Redistributions in binary form must reproduce the above copyright notice, 
+**     this list of conditions and the following disclaimer in the documentation 
+**     and/or other materials provided with the distribution.
+**   - Neither the name of The University of Manchester nor the names of its 
+**     contributors may be used to endorse or promote products derived from this 
+**     software without specific prior written permission.
+** 
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+** ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+** ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+** (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+** LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+** ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+** SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+*******************************************************************************/
+
+
+#include "FEAST/FSToolbox.h"
+#include "FSInternal.h"
+
+/*******************************************************************************
+** countBits() counts the set bits in a word. GCC and clang provide a builtin
+** which uses the popcnt instruction when the target has one, otherwise the
+** bits are summed in parallel, with the masks derived from ~0 so it works
+** for any width of unsigned long.
+*******************************************************************************/
+#if defined(__GNUC__)
+  #define countBits(word) __builtin_popcountl(word)
+#else
+static int countBits(FSWord word) {
+    word = word - ((word >> 1) & (~0UL / 3));
+    word = (word & (~0UL / 5)) + ((word >> 2) & (~0UL / 5));
+    word = (word + (word >> 4)) & (~0UL / 17);
+    return (int) ((word * (~0UL / 255)) >> ((sizeof(FSWord) - 1) * CHAR_BIT));
+}/*countBits(FSWord)*/
+#endif
+
+int bitmapWords(int vectorLength) {
+    return (vectorLength + FS_WORD_BITS - 1) / FS_WORD_BITS;
+}/*bitmapWords(int)*/
+
+void buildColumnBitmap(FSColumn *column, int vectorLength, FSWord *bits) {
+    int numWords = bitmapWords(vectorLength);
+    int block[FS_BLOCK_SIZE];
+    int start, length, i, sample;
+
+    for (start = 0; start < vectorLength; start += FS_BLOCK_SIZE) {
+        length = vectorLength - start < FS_BLOCK_SIZE ? vectorLength - start : FS_BLOCK_SIZE;
+        loadColumnBlock(column,start,length,block);
+        for (i = 0; i < length; i++) {
+            sample = start + i;
+            bits[block[i] * numWords + sample / FS_WORD_BITS] |= 1UL << (sample % FS_WORD_BITS);
+        }
+    }
+
+    column->bits = bits;
+}/*buildColumnBitmap(FSColumn*,int,FSWord[])*/
+
+void buildColumnBitmaps(FSColumnSet *set) {
+    int numWords = bitmapWords(set->noOfSamples);
+    size_t storageSize = 0;
+    FSWord *storagePosition;
+    FSColumn *column;
+    uint i;
+
+    /*a bitset can't weight its rows by their counts*/
+    if (set->rowCounts != NULL) {
+        return;
+    }
+
+    /*the class is treated as column noOfFeatures*/
+    for (i = 0; i <= set->noOfFeatures; i++) {
+        column = i < set->noOfFeatures ? set->features + i : &(set->classColumn);
+        if (column->numStates <= FS_BITMAP_MAX_STATES) {
+            storageSize += column->numStates * numWords;
+        }
+    }
+
+    if (storageSize > 0) {
+        set->bitmapStorage = (FSWord *) CALLOC_FUNC(storageSize,sizeof(FSWord));
+    }
+
+    /*the index only saves time, so the columns are counted without it if the memory isn't there*/
+    if (set->bitmapStorage != NULL) {
+        storagePosition = set->bitmapStorage;
+
+        for (i = 0; i <= set->noOfFeatures; i++) {
+            column = i < set->noOfFeatures ? set->features + i : &(set->classColumn);
+            if (column->numStates <= FS_BITMAP_MAX_STATES) {
+                buildColumnBitmap(column,set->noOfSamples,storagePosition);
+                storagePosition += column->numStates * numWords;
+            }
+        }
+    }
+}/*buildColumnBitmaps(FSColumnSet*)*/
+
+int useBitmapStatistics(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn) {
+    return (firstColumn->bits != NULL) && (secondColumn->bits != NULL) && (classColumn->bits != NULL)
+        && (firstColumn->numStates * secondColumn->numStates * classColumn->numStates <= FS_BITMAP_MAX_CELLS);
+}/*useBitmapStatistics(FSColumn*,FSColumn*,FSColumn*)*/
+
+/*******************************************************************************
+** lowestBit() returns the index of the lowest set bit of a non-zero word,
+** using the count trailing zeros builtin where there is one.
+*******************************************************************************/
+#if defined(__GNUC__)
+  #define lowestBit(word) __builtin_ctzl(word)
+#else
+static int lowestBit(FSWord word) {
+    int bit = 0;
+
+    while ((word & 1UL) == 0) {
+        word >>= 1;
+        bit++;
+    }
+
+    return bit;
+}/*lowestBit(FSWord)*/
+#endif
+
+JointStatistics calcBitmapStatistics(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn, int vectorLength) {
+    int firstNumStates = firstColumn->numStates;
+    int secondNumStates = secondColumn->numStates;
+    int classNumStates = classColumn->numStates;
+    int numCells = firstNumStates * secondNumStates;
+    int numWords = bitmapWords(vectorLength);
+
+    /*the full table by cell a + b*firstNumStates, then the observed pairs in order*/
+    int cellCounts[FS_BITMAP_MAX_CELLS];
+    int jointCounts[FS_BITMAP_MAX_CELLS];
+    int firstRows[FS_BITMAP_MAX_CELLS];
+    int pairCells[FS_BITMAP_MAX_CELLS];
+    uint pairFirst[FS_BITMAP_MAX_CELLS];
+    uint pairSecond[FS_BITMAP_MAX_CELLS];
+    int tableCounts[FS_BITMAP_TABLE_COUNTS];
+
+    FSWord secondWord, pairWord;
+    int numPairStates = 0;
+    int cell, w, a, b, c, i;
+
+    memset(cellCounts, 0, sizeof(int) * numCells * classNumStates);
+    memset(tableCounts, 0, sizeof(int) * tableCountsLength(numCells,firstNumStates,secondNumStates,classNumStates));
+
+    for (cell = 0; cell < numCells; cell++) {
+        firstRows[cell] = -1;
+    }
+
+    for (w = 0; w < numWords; w++) {
+        for (b = 0; b < secondNumStates; b++) {
+            secondWord = secondColumn->bits[b * numWords + w];
+            if (secondWord != 0) {
+                for (a = 0; a < firstNumStates; a++) {
+                    pairWord = firstColumn->bits[a * numWords + w] & secondWord;
+                    if (pairWord != 0) {
+                        cell = a + b * firstNumStates;
+                        if (firstRows[cell] == -1) {
+                            firstRows[cell] = w * FS_WORD_BITS + lowestBit(pairWord);
+                        }
+                        for (c = 0; c < classNumStates; c++) {
+                            cellCounts[cell + numCells * c] += countBits(pairWord & classColumn->bits[c * numWords + w]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /*insertion sort of the observed cells by first row, no two share a row*/
+    for (cell = 0; cell < numCells; cell++) {
+        if (firstRows[cell] != -1) {
+            i = numPairStates;
+            while ((i > 0) && (firstRows[pairCells[i - 1]] > firstRows[cell])) {
+                pairCells[i] = pairCells[i - 1];
+                i--;
+            }
+            pairCells[i] = cell;
+            numPairStates++;
+        }
+    }
+
+    for (i = 0; i < numPairStates; i++) {
+        cell = pairCells[i];
+        pairFirst[i] = cell % firstNumStates;
+        pairSecond[i] = cell / firstNumStates;
+        for (c = 0; c < classNumStates; c++) {
+            jointCounts[i + numPairStates * c] = cellCounts[cell + numCells * c];
+        }
+    }
+
+    /*JointStatistics tableStatistics(int *jointCounts, int numPairStates, uint *pairFirst, uint *pairSecond, int firstNumStates, int secondNumStates, int classNumStates, int vectorLength, int *pairCounts);*/
+    return tableStatistics(jointCounts,numPairStates,pairFirst,pairSecond,firstNumStates,secondNumStates,classNumStates,vectorLength,tableCounts);
+}/*calcBitmapStatistics(FSColumn*,FSColumn*,FSColumn*,int)*/
@@ -0,0 +1,588 @@
+/*******************************************************************************
+** FSColumns.c
+** Implements the column storage used inside the FEAST algorithms. Each
+** discrete column is stored at the narrowest width which holds its states,
+** and the MI kernels read the columns a block of samples at a time, widening
+** them into a small int buffer. Sparse columns hold only their nonzero
+** samples, and are expanded a block at a time. Duplicate rows can be
+** collapsed into a single row weighted by its number of samples.
+**
+** Author: Adam Pocock
+** Created: 17/10/2026
+**
+** Part of the FEAture Selection Toolbox (FEAST), please reference
+** "Conditional Likelihood Maximisation: A Unifying Framework for Information
+** Theoretic Feature Selection"
+** G. Brown, A. Pocock, M.-J. Zhao, M. Lujan
+** Journal of Machine Learning Research (JMLR), 2012
+**
+** Please check www.github.com/Craigacp/FEAST for updates.
+** 
+** Copyright (c) 2010-2017, A. Pocock, G. Brown, The University of Manchester
+** All rights reserved.
+** 
+** Redistribution and use in source and binary forms, with or without modification,
+** are permitted provided that the following conditions are met:
+** 
+**   - Redistributions of source code must retain the above copyright notice, this 
+**     list of conditions and the following disclaimer.
+**   - Redistributions in binary form must reproduce the above copyright notice, 
+**     this list of conditions and the following disclaimer in the documentation 
+**     and/or other materials provided with the distribution.
+**   - Neither the name of The University of Manchester nor the names of its 
+**     contributors may be used to endorse or promote products derived from this 
+**     software without specific prior written permission.
+** 
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+** ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+** ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+** (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+** LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+** ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+** SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+*******************************************************************************/
+
+
+#include "FEAST/FSToolbox.h"
+#include "FSInternal.h"
+
+/* MIToolbox includes */
+#include "MIToolbox/ArrayOperations.h"
+
+int columnWidth(int numStates) {
+    if (numStates <= 256) {
+        return sizeof(unsigned char);
+    } else if (numStates <= 65536) {
+        return sizeof(unsigned short);
+    } else {
+        return sizeof(uint);
+    }
+}/*columnWidth(int)*/
+
+/*each column in the storage block starts on a uint boundary*/
+static size_t paddedSize(uint noOfSamples, int width) {
+    return ((noOfSamples * width + sizeof(uint) - 1) / sizeof(uint)) * sizeof(uint);
+}/*paddedSize(uint,int)*/
+
+static void storeColumn(FSColumn *column, uint *inputVector, uint noOfSamples) {
+    uint i;
+
+    if (column->width == sizeof(unsigned char)) {
+        unsigned char *data = (unsigned char *) column->data;
+        for (i = 0; i < noOfSamples; i++) {
+            data[i] = (unsigned char) inputVector[i];
+        }
+    } else if (column->width == sizeof(unsigned short)) {
+        unsigned short *data = (unsigned short *) column->data;
+        for (i = 0; i < noOfSamples; i++) {
+            data[i] = (unsigned short) inputVector[i];
+        }
+    } else {
+        memcpy(column->data, inputVector, sizeof(uint)*noOfSamples);
+    }
+}/*storeColumn(FSColumn*,uint[],uint)*/
+
+/*******************************************************************************
+** columnCalloc() allocates as checkedCalloc() does if exitOnFailure is set,
+** and otherwise returns NULL if the memory isn't available.
+*******************************************************************************/
+static void* columnCalloc(size_t length, size_t size, int exitOnFailure) {
+    return exitOnFailure ? checkedCalloc(length,size) : CALLOC_FUNC(length,size);
+}/*columnCalloc(size_t,size_t,int)*/
+
+/*******************************************************************************
+** buildColumnSet() is createColumnSet(), returning FS_ERROR_MEMORY with
+** nothing allocated if the column array or the compact copies can't be
+** allocated and exitOnFailure isn't set.
+*******************************************************************************/
+static int buildColumnSet(uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, FSOptions *options, FSColumnSet *set, int exitOnFailure) {
+    int compact = (options != NULL) && options->compactStorage;
+    size_t storageSize = 0;
+    char *storagePosition;
+    FSColumn *column;
+    uint *inputVector;
+    uint i;
+
+    set->noOfSamples = noOfSamples;
+    set->noOfFeatures = noOfFeatures;
+    set->features = (FSColumn *) columnCalloc(noOfFeatures + 1,sizeof(FSColumn),exitOnFailure);
+    if (set->features == NULL) {
+        return FS_ERROR_MEMORY;
+    }
+    set->storage = NULL;
+    set->bitmapStorage = NULL;
+    set->classMI = NULL;
+    set->entropies = NULL;
+    set->rowCounts = NULL;
+
+    /*the class is treated as column noOfFeatures*/
+    for (i = 0; i <= noOfFeatures; i++) {
+        column = i < noOfFeatures ? set->features + i : &(set->classColumn);
+        inputVector = i < noOfFeatures ? featureMatrix[i] : classColumn;
+        column->numStates = maxState(inputVector,noOfSamples);
+        column->width = compact ? columnWidth(column->numStates) : sizeof(uint);
+        column->bits = NULL;
+        column->rowIndices = NULL;
+        column->noOfEntries = noOfSamples;
+        column->stateCounts = NULL;
+        column->rowCounts = NULL;
+        if (compact) {
+            storageSize += paddedSize(noOfSamples,column->width);
+        }
+    }
+
+    if (storageSize > 0) {
+        set->storage = columnCalloc(storageSize,sizeof(char),exitOnFailure);
+        if (set->storage == NULL) {
+            FREE_FUNC(set->features);
+            set->features = NULL;
+            return FS_ERROR_MEMORY;
+        }
+    }
+    storagePosition = (char *) set->storage;
+
+    for (i = 0; i <= noOfFeatures; i++) {
+        column = i < noOfFeatures ? set->features + i : &(set->classColumn);
+        inputVector = i < noOfFeatures ? featureMatrix[i] : classColumn;
+        if (!compact) {
+            column->data = inputVector;
+        } else {
+            column->data = storagePosition;
+            storeColumn(column,inputVector,noOfSamples);
+            storagePosition += paddedSize(noOfSamples,column->width);
+        }
+    }
+
+    if ((options != NULL) && options->deduplicateRows) {
+        deduplicateColumnSet(set);
+    }
+
+    if ((options != NULL) && options->bitmapIndex) {
+        buildColumnBitmaps(set);
+    }
+
+    return FS_OK;
+}/*buildColumnSet(uint,uint,uint[][],uint[],FSOptions*,FSColumnSet*,int)*/
+
+void createColumnSet(uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, FSOptions *options, FSColumnSet *set) {
+    buildColumnSet(noOfSamples, noOfFeatures, featureMatrix, classColumn, options, set, 1);
+}/*createColumnSet(uint,uint,uint[][],uint[],FSOptions*,FSColumnSet*)*/
+
+int tryCreateColumnSet(uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, FSOptions *options, FSColumnSet *set) {
+    return buildColumnSet(noOfSamples, noOfFeatures, featureMatrix, classColumn, options, set, 0);
+}/*tryCreateColumnSet(uint,uint,uint[][],uint[],FSOptions*,FSColumnSet*)*/
+
+void normaliseColumnSet(uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, FSColumnSet *set) {
+    uint *normalisedVector = (uint *) checkedCalloc(noOfSamples,sizeof(uint));
+    size_t storageSize = 0;
+    char *storagePosition;
+    FSColumn *column;
+    double *inputVector;
+    uint i;
+
+    set->noOfSamples = noOfSamples;
+    set->noOfFeatures = noOfFeatures;
+    set->features = (FSColumn *) checkedCalloc(noOfFeatures,sizeof(FSColumn));
+    set->bitmapStorage = NULL;
+    set->classMI = NULL;
+    set->entropies = NULL;
+    set->rowCounts = NULL;
+
+    /*the widths aren't known until each column has been normalised once, so
+     **each column is normalised twice rather than holding a full uint copy*/
+    for (i = 0; i <= noOfFeatures; i++) {
+        column = i < noOfFeatures ? set->features + i : &(set->classColumn);
+        inputVector = i < noOfFeatures ? featureMatrix[i] : classColumn;
+        column->numStates = normaliseArray(inputVector,normalisedVector,noOfSamples);
+        column->width = columnWidth(column->numStates);
+        column->bits = NULL;
+        column->rowIndices = NULL;
+        column->noOfEntries = noOfSamples;
+        column->stateCounts = NULL;
+        column->rowCounts = NULL;
+        storageSize += paddedSize(noOfSamples,column->width);
+    }
+
+    set->storage = checkedCalloc(storageSize,sizeof(char));
+    storagePosition = (char *) set->storage;
+
+    for (i = 0; i <= noOfFeatures; i++) {
+        column = i < noOfFeatures ? set->features + i : &(set->classColumn);
+        inputVector = i < noOfFeatures ? featureMatrix[i] : classColumn;
+        normaliseArray(inputVector,normalisedVector,noOfSamples);
+        column->data = storagePosition;
+        storeColumn(column,normalisedVector,noOfSamples);
+        storagePosition += paddedSize(noOfSamples,column->width);
+    }
+
+    FREE_FUNC(normalisedVector);
+    normalisedVector = NULL;
+}/*normaliseColumnSet(uint,uint,double[][],double[],FSColumnSet*)*/
+
+void createSparseColumnSet(uint noOfSamples, uint noOfFeatures, uint *columnStarts, uint *rowIndices, uint *values, uint *classColumn, FSOptions *options, FSColumnSet *set) {
+    uint noOfEntries = columnStarts[noOfFeatures] - columnStarts[0];
+    uint *storagePosition;
+    FSColumn *column;
+    uint i, j;
+
+    set->noOfSamples = noOfSamples;
+    set->noOfFeatures = noOfFeatures;
+    set->features = (FSColumn *) checkedCalloc(noOfFeatures,sizeof(FSColumn));
+    set->bitmapStorage = NULL;
+    set->classMI = NULL;
+    set->entropies = NULL;
+    set->rowCounts = NULL;
+
+    /*the row indices and values of every column, then the class*/
+    set->storage = checkedCalloc(2*noOfEntries + noOfSamples,sizeof(uint));
+    storagePosition = (uint *) set->storage;
+
+    for (i = 0; i < noOfFeatures; i++) {
+        column = set->features + i;
+        column->noOfEntries = columnStarts[i+1] - columnStarts[i];
+        column->rowIndices = storagePosition;
+        column->data = storagePosition + column->noOfEntries;
+        column->width = sizeof(uint);
+        column->bits = NULL;
+        column->stateCounts = NULL;
+        column->rowCounts = NULL;
+        storagePosition += 2*column->noOfEntries;
+
+        memcpy(column->rowIndices, rowIndices + columnStarts[i], sizeof(uint)*column->noOfEntries);
+        memcpy(column->data, values + columnStarts[i], sizeof(uint)*column->noOfEntries);
+
+        /*the implicit zeros mean there is always at least one state*/
+        column->numStates = 1;
+        for (j = 0; j < column->noOfEntries; j++) {
+            if (values[columnStarts[i] + j] >= column->numStates) {
+                column->numStates = values[columnStarts[i] + j] + 1;
+            }
+        }
+    }
+
+    column = &(set->classColumn);
+    column->numStates = maxState(classColumn,noOfSamples);
+    column->noOfEntries = noOfSamples;
+    column->rowIndices = NULL;
+    column->data = storagePosition;
+    column->width = sizeof(uint);
+    column->bits = NULL;
+    column->rowCounts = NULL;
+    memcpy(column->data, classColumn, sizeof(uint)*noOfSamples);
+
+    column->stateCounts = (int *) checkedCalloc(column->numStates,sizeof(int));
+    for (i = 0; i < noOfSamples; i++) {
+        column->stateCounts[classColumn[i]]++;
+    }
+
+    if ((options != NULL) && options->bitmapIndex) {
+        buildColumnBitmaps(set);
+    }
+}/*createSparseColumnSet(uint,uint,uint[],uint[],uint[],uint[],FSOptions*,FSColumnSet*)*/
+
+/*******************************************************************************
+** sameRow() is true if rows first and second of a set hold the same values
+** in every feature and the class.
+*******************************************************************************/
+static int sameRow(FSColumnSet *set, int first, int second) {
+    uint i;
+
+    if (columnValue(&(set->classColumn),first) != columnValue(&(set->classColumn),second)) {
+        return 0;
+    }
+
+    for (i = 0; i < set->noOfFeatures; i++) {
+        if (columnValue(set->features + i,first) != columnValue(set->features + i,second)) {
+            return 0;
+        }
+    }
+
+    return 1;
+}/*sameRow(FSColumnSet*,int,int)*/
+
+void deduplicateColumnSet(FSColumnSet *set) {
+    uint noOfSamples = set->noOfSamples;
+    uint noOfFeatures = set->noOfFeatures;
+
+    /*an FNV style hash of each row, built up a column at a time*/
+    unsigned long *rowHashes = (unsigned long *) CALLOC_FUNC(noOfSamples,sizeof(unsigned long));
+    /*open addressing table holding one more than the index of a distinct row, 0 if empty*/
+    uint tableSize = 1;
+    uint *hashTable;
+    /*the first sample of each distinct row, in increasing order*/
+    uint *firstSamples = (uint *) CALLOC_FUNC(noOfSamples,sizeof(uint));
+    uint *rowCounts = (uint *) CALLOC_FUNC(noOfSamples,sizeof(uint));
+    uint noOfRows = 0;
+
+    uint *rowVector = NULL, *distinctCounts = NULL;
+    size_t storageSize = 0;
+    char *storage = NULL, *storagePosition;
+    FSColumn *column;
+    int block[FS_BLOCK_SIZE];
+    int start, length;
+    unsigned long hash;
+    uint slot, i, j;
+
+    while (tableSize < 2 * noOfSamples) {
+        tableSize *= 2;
+    }
+    hashTable = (uint *) CALLOC_FUNC(tableSize,sizeof(uint));
+
+    /*collapsing the rows only saves time, so the set is left as it is if the memory isn't there*/
+    if ((rowHashes != NULL) && (firstSamples != NULL) && (rowCounts != NULL) && (hashTable != NULL)) {
+        for (i = 0; i < noOfSamples; i++) {
+            rowHashes[i] = 2166136261UL;
+        }
+
+        /*the class is treated as column noOfFeatures*/
+        for (j = 0; j <= noOfFeatures; j++) {
+            column = j < noOfFeatures ? set->features + j : &(set->classColumn);
+            for (start = 0; start < (int) noOfSamples; start += FS_BLOCK_SIZE) {
+                length = (int) noOfSamples - start < FS_BLOCK_SIZE ? (int) noOfSamples - start : FS_BLOCK_SIZE;
+                loadColumnBlock(column,start,length,block);
+                for (i = 0; i < (uint) length; i++) {
+                    rowHashes[start + i] = (rowHashes[start + i] ^ (unsigned long) block[i]) * 16777619UL;
+                }
+            }
+        }
+
+        for (i = 0; i < noOfSamples; i++) {
+            hash = rowHashes[i];
+            slot = (uint) ((hash ^ (hash >> 16)) & (tableSize - 1));
+            while ((hashTable[slot] != 0) &&
+                   ((rowHashes[firstSamples[hashTable[slot] - 1]] != hash) || !sameRow(set, firstSamples[hashTable[slot] - 1], i))) {
+                slot = (slot + 1) & (tableSize - 1);
+            }
+            if (hashTable[slot] == 0) {
+                firstSamples[noOfRows] = i;
+                noOfRows++;
+                hashTable[slot] = noOfRows;
+            }
+            rowCounts[hashTable[slot] - 1]++;
+        }
+
+        if (noOfRows < noOfSamples) {
+            /*the distinct rows are copied out of the old columns at their narrowest width*/
+            for (j = 0; j <= noOfFeatures; j++) {
+                column = j < noOfFeatures ? set->features + j : &(set->classColumn);
+                storageSize += paddedSize(noOfRows,columnWidth(column->numStates));
+            }
+
+            storage = (char *) CALLOC_FUNC(storageSize,sizeof(char));
+            rowVector = (uint *) CALLOC_FUNC(noOfRows,sizeof(uint));
+            distinctCounts = (uint *) CALLOC_FUNC(noOfRows,sizeof(uint));
+        }
+    }
+
+    if ((storage != NULL) && (rowVector != NULL) && (distinctCounts != NULL)) {
+        set->rowCounts = distinctCounts;
+        memcpy(set->rowCounts, rowCounts, sizeof(uint)*noOfRows);
+        distinctCounts = NULL;
+        storagePosition = storage;
+
+        for (j = 0; j <= noOfFeatures; j++) {
+            column = j < noOfFeatures ? set->features + j : &(set->classColumn);
+            for (i = 0; i < noOfRows; i++) {
+                rowVector[i] = columnValue(column,firstSamples[i]);
+            }
+            column->data = storagePosition;
+            column->width = columnWidth(column->numStates);
+            column->bits = NULL;
+            column->noOfEntries = noOfRows;
+            column->rowCounts = set->rowCounts;
+            storeColumn(column,rowVector,noOfRows);
+            storagePosition += paddedSize(noOfRows,column->width);
+        }
+
+        if (set->storage != NULL) {
+            FREE_FUNC(set->storage);
+        }
+        if (set->bitmapStorage != NULL) {
+            FREE_FUNC(set->bitmapStorage);
+            set->bitmapStorage = NULL;
+        }
+        set->storage = storage;
+        set->noOfSamples = noOfRows;
+    } else {
+        if (storage != NULL) {
+            FREE_FUNC(storage);
+        }
+        if (distinctCounts != NULL) {
+            FREE_FUNC(distinctCounts);
+        }
+    }
+    storage = NULL;
+    distinctCounts = NULL;
+
+    if (rowVector != NULL) {
+        FREE_FUNC(rowVector);
+        rowVector = NULL;
+    }
+    if (rowHashes != NULL) {
+        FREE_FUNC(rowHashes);
+        rowHashes = NULL;
+    }
+    if (hashTable != NULL) {
+        FREE_FUNC(hashTable);
+        hashTable = NULL;
+    }
+    if (firstSamples != NULL) {
+        FREE_FUNC(firstSamples);
+        firstSamples = NULL;
+    }
+    if (rowCounts != NULL) {
+        FREE_FUNC(rowCounts);
+        rowCounts = NULL;
+    }
+}/*deduplicateColumnSet(FSColumnSet*)*/
+
+void freeColumnSet(FSColumnSet *set) {
+    FREE_FUNC(set->features);
+    set->features = NULL;
+
+    if (set->storage != NULL) {
+        FREE_FUNC(set->storage);
+        set->storage = NULL;
+    }
+
+    if (set->bitmapStorage != NULL) {
+        FREE_FUNC(set->bitmapStorage);
+        set->bitmapStorage = NULL;
+    }
+
+    if (set->classMI != NULL) {
+        FREE_FUNC(set->classMI);
+        set->classMI = NULL;
+    }
+
+    if (set->entropies != NULL) {
+        FREE_FUNC(set->entropies);
+        set->entropies = NULL;
+    }
+
+    if (set->classColumn.stateCounts != NULL) {
+        FREE_FUNC(set->classColumn.stateCounts);
+        set->classColumn.stateCounts = NULL;
+    }
+
+    if (set->rowCounts != NULL) {
+        FREE_FUNC(set->rowCounts);
+        set->rowCounts = NULL;
+    }
+}/*freeColumnSet(FSColumnSet*)*/
+
+/*******************************************************************************
+** firstEntry() returns the position of the first entry of a sparse column
+** with a row index of at least start.
+*******************************************************************************/
+static int firstEntry(FSColumn *column, int start) {
+    int low = 0;
+    int high = column->noOfEntries;
+    int middle;
+
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        if (column->rowIndices[middle] < (uint) start) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low;
+}/*firstEntry(FSColumn*,int)*/
+
+void loadColumnBlock(FSColumn *column, int start, int length, int *block) {
+    uint *values = (uint *) column->data;
+    int i;
+
+    if (column->rowIndices != NULL) {
+        memset(block, 0, sizeof(int)*length);
+        for (i = firstEntry(column,start); (i < column->noOfEntries) && (column->rowIndices[i] < (uint) (start + length)); i++) {
+            block[column->rowIndices[i] - start] = values[i];
+        }
+    } else if (column->width == sizeof(unsigned char)) {
+        unsigned char *data = ((unsigned char *) column->data) + start;
+        for (i = 0; i < length; i++) {
+            block[i] = data[i];
+        }
+    } else if (column->width == sizeof(unsigned short)) {
+        unsigned short *data = ((unsigned short *) column->data) + start;
+        for (i = 0; i < length; i++) {
+            block[i] = data[i];
+        }
+    } else {
+        uint *data = ((uint *) column->data) + start;
+        for (i = 0; i < length; i++) {
+            block[i] = data[i];
+        }
+    }
+}/*loadColumnBlock(FSColumn*,int,int,int[])*/
+
+void addColumnBlock(FSColumn *column, int start, int length, int multiplier, int *block) {
+    uint *values = (uint *) column->data;
+    int i;
+
+    if (column->rowIndices != NULL) {
+        for (i = firstEntry(column,start); (i < column->noOfEntries) && (column->rowIndices[i] < (uint) (start + length)); i++) {
+            block[column->rowIndices[i] - start] += values[i] * multiplier;
+        }
+    } else if (column->width == sizeof(unsigned char)) {
+        unsigned char *data = ((unsigned char *) column->data) + start;
+        for (i = 0; i < length; i++) {
+            block[i] += data[i] * multiplier;
+        }
+    } else if (column->width == sizeof(unsigned short)) {
+        unsigned short *data = ((unsigned short *) column->data) + start;
+        for (i = 0; i < length; i++) {
+            block[i] += data[i] * multiplier;
+        }
+    } else {
+        uint *data = ((uint *) column->data) + start;
+        for (i = 0; i < length; i++) {
+            block[i] += data[i] * multiplier;
+        }
+    }
+}/*addColumnBlock(FSColumn*,int,int,int,int[])*/
+
+void unpackColumn(FSColumn *column, int vectorLength, uint *outputVector) {
+    int block[FS_BLOCK_SIZE];
+    int start, length, i;
+
+    for (start = 0; start < vectorLength; start += FS_BLOCK_SIZE) {
+        length = vectorLength - start < FS_BLOCK_SIZE ? vectorLength - start : FS_BLOCK_SIZE;
+        loadColumnBlock(column,start,length,block);
+        for (i = 0; i < length; i++) {
+            outputVector[start + i] = block[i];
+        }
+    }
+}/*unpackColumn(FSColumn*,int,uint[])*/
+
+int columnValue(FSColumn *column, int row) {
+    if (column->width == sizeof(unsigned char)) {
+        return ((unsigned char *) column->data)[row];
+    } else if (column->width == sizeof(unsigned short)) {
+        return ((unsigned short *) column->data)[row];
+    } else {
+        return ((uint *) column->data)[row];
+    }
+}/*columnValue(FSColumn*,int)*/
+
+int countedLength(FSColumn *column, int vectorLength) {
+    int totalLength = 0;
+    int i;
+
+    if (column->rowCounts == NULL) {
+        return vectorLength;
+    }
+
+    for (i = 0; i < vectorLength; i++) {
+        totalLength += column->rowCounts[i];
+    }
+
+    return totalLength;
+}/*countedLength(FSColumn*,int)*/
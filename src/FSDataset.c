@@ -0,0 +1,349 @@
+/*******************************************************************************
+** FSDataset.c
+** Implements FEASTDataset. The columns are copied or normalised into compact
+** storage once, and the class MI and column entropies are calculated when the
+** dataset is created so every algorithm run on it can reuse them. Duplicate
+** rows can be collapsed into counted rows at the same time, and the constant
+** and duplicate features left out of the search.
+**
+** Author: Adam Pocock
+** Created: 17/10/2026
+**
+** Part of the FEAture Selection Toolbox (FEAST), please reference
+** "Conditional Likelihood Maximisation: A Unifying Framework for Information
+** Theoretic Feature Selection"
+** G. Brown, A. Pocock, M.-J. Zhao, M. Lujan
+** Journal of Machine Learning Research (JMLR), 2012
+**
+** Please check www.github.com/Craigacp/FEAST for updates.
+** 
+** Copyright (c) 2010-2017, A. Pocock, G. Brown, The University of Manchester
+** All rights reserved.
+** 
+** Redistribution and use in source and binary forms, with or without modification,
+** are permitted provided that the following conditions are met:
+** 
+**   - Redistributions of source code must retain the above copyright notice, this 
+**     list of conditions and the following disclaimer.
+**   - Redistributions in binary form must reproduce the above copyright notice, 
+**     this list of conditions and the following disclaimer in the documentation 
+**     and/or other materials provided with the distribution.
+**   - Neither the name of The University of Manchester nor the names of its 
+**     contributors may be used to endorse or promote products derived from this 
+**     software without specific prior written permission.
+** 
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+** ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+** ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+** (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+** LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+** ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+** SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+*******************************************************************************/
+
+
+#include "FEAST/FSDataset.h"
+#include "FEAST/FSToolbox.h"
+#include "FSInternal.h"
+
+static void cacheDatasetValues(FEASTDataset *dataset, FSOptions *options) {
+    FSColumnSet *set = &(dataset->set);
+    double *classMI = (double *) checkedCalloc(set->noOfFeatures,sizeof(double));
+    double *entropies = (double *) checkedCalloc(set->noOfFeatures + 1,sizeof(double));
+
+    /*calculateClassMI and calculateEntropies copy from the cache if it is set, so fill them first*/
+    calculateClassMI(set, classMI, options);
+    calculateEntropies(set, entropies, options);
+
+    set->classMI = classMI;
+    set->entropies = entropies;
+}/*cacheDatasetValues(FEASTDataset*,FSOptions*)*/
+
+/*******************************************************************************
+** columnFingerprint() hashes the nonzero samples of a column with their row
+** indices, so a dense column and a sparse one with the same samples hash to
+** the same value.
+*******************************************************************************/
+static unsigned long columnFingerprint(FSColumn *column, int vectorLength) {
+    unsigned long hash = 2166136261UL;
+    uint *values = (uint *) column->data;
+    int block[FS_BLOCK_SIZE];
+    int start, length, i;
+
+    if (column->rowIndices != NULL) {
+        for (i = 0; i < column->noOfEntries; i++) {
+            if (values[i] != 0) {
+                hash = (hash ^ column->rowIndices[i]) * 16777619UL;
+                hash = (hash ^ values[i]) * 16777619UL;
+            }
+        }
+    } else {
+        for (start = 0; start < vectorLength; start += FS_BLOCK_SIZE) {
+            length = vectorLength - start < FS_BLOCK_SIZE ? vectorLength - start : FS_BLOCK_SIZE;
+            loadColumnBlock(column,start,length,block);
+            for (i = 0; i < length; i++) {
+                if (block[i] != 0) {
+                    hash = (hash ^ (unsigned long) (start + i)) * 16777619UL;
+                    hash = (hash ^ (unsigned long) block[i]) * 16777619UL;
+                }
+            }
+        }
+    }
+
+    return hash;
+}/*columnFingerprint(FSColumn*,int)*/
+
+/*******************************************************************************
+** sameColumn() is true if two columns hold the same value in every sample.
+*******************************************************************************/
+static int sameColumn(FSColumn *firstColumn, FSColumn *secondColumn, int vectorLength) {
+    int firstBlock[FS_BLOCK_SIZE];
+    int secondBlock[FS_BLOCK_SIZE];
+    int start, length;
+
+    if (firstColumn->numStates != secondColumn->numStates) {
+        return 0;
+    }
+
+    for (start = 0; start < vectorLength; start += FS_BLOCK_SIZE) {
+        length = vectorLength - start < FS_BLOCK_SIZE ? vectorLength - start : FS_BLOCK_SIZE;
+        loadColumnBlock(firstColumn,start,length,firstBlock);
+        loadColumnBlock(secondColumn,start,length,secondBlock);
+        if (memcmp(firstBlock, secondBlock, sizeof(int)*length) != 0) {
+            return 0;
+        }
+    }
+
+    return 1;
+}/*sameColumn(FSColumn*,FSColumn*,int)*/
+
+/*******************************************************************************
+** removeRedundantFeatures() builds the search set of a dataset, leaving out
+** the constant features and every feature which duplicates an earlier one.
+** Constant features have an entropy of exactly zero. If every feature is
+** constant the first one is kept so there is something to select.
+*******************************************************************************/
+static void removeRedundantFeatures(FEASTDataset *dataset) {
+    FSColumnSet *set = &(dataset->set);
+    FSColumnSet *searchSet = &(dataset->searchSet);
+    uint noOfFeatures = set->noOfFeatures;
+
+    unsigned long *fingerprints = (unsigned long *) checkedCalloc(noOfFeatures,sizeof(unsigned long));
+    /*open addressing table holding one more than the index of a kept feature, 0 if empty*/
+    uint tableSize = 1;
+    uint *hashTable;
+    uint *featureIndices = (uint *) checkedCalloc(noOfFeatures,sizeof(uint));
+    uint noOfKept = 0;
+    uint slot, i, j;
+
+    while (tableSize < 2 * noOfFeatures) {
+        tableSize *= 2;
+    }
+    hashTable = (uint *) checkedCalloc(tableSize,sizeof(uint));
+
+    for (i = 0; i < noOfFeatures; i++) {
+        if (set->entropies[i] != 0.0) {
+            fingerprints[i] = columnFingerprint(set->features + i, set->noOfSamples);
+            slot = (uint) ((fingerprints[i] ^ (fingerprints[i] >> 16)) & (tableSize - 1));
+            while ((hashTable[slot] != 0) &&
+                   ((fingerprints[featureIndices[hashTable[slot] - 1]] != fingerprints[i]) || !sameColumn(set->features + featureIndices[hashTable[slot] - 1], set->features + i, set->noOfSamples))) {
+                slot = (slot + 1) & (tableSize - 1);
+            }
+            if (hashTable[slot] == 0) {
+                featureIndices[noOfKept] = i;
+                noOfKept++;
+                hashTable[slot] = noOfKept;
+            }
+        }
+    }
+
+    if ((noOfKept == 0) && (noOfFeatures > 0)) {
+        featureIndices[0] = 0;
+        noOfKept = 1;
+    }
+
+    if (noOfKept < noOfFeatures) {
+        *searchSet = *set;
+        searchSet->noOfFeatures = noOfKept;
+        searchSet->features = (FSColumn *) checkedCalloc(noOfKept,sizeof(FSColumn));
+        searchSet->storage = NULL;
+        searchSet->bitmapStorage = NULL;
+        searchSet->classMI = (double *) checkedCalloc(noOfKept,sizeof(double));
+        searchSet->entropies = (double *) checkedCalloc(noOfKept + 1,sizeof(double));
+
+        for (j = 0; j < noOfKept; j++) {
+            searchSet->features[j] = set->features[featureIndices[j]];
+            searchSet->classMI[j] = set->classMI[featureIndices[j]];
+            searchSet->entropies[j] = set->entropies[featureIndices[j]];
+        }
+        searchSet->entropies[noOfKept] = set->entropies[noOfFeatures];
+
+        dataset->featureIndices = (uint *) checkedCalloc(noOfKept,sizeof(uint));
+        memcpy(dataset->featureIndices, featureIndices, sizeof(uint)*noOfKept);
+    }
+
+    FREE_FUNC(fingerprints);
+    FREE_FUNC(hashTable);
+    FREE_FUNC(featureIndices);
+
+    fingerprints = NULL;
+    hashTable = NULL;
+    featureIndices = NULL;
+}/*removeRedundantFeatures(FEASTDataset*)*/
+
+void finishDataset(FEASTDataset *dataset, FSOptions *options) {
+    cacheDatasetValues(dataset, options);
+    dataset->featureIndices = NULL;
+
+    if ((options != NULL) && options->removeRedundantFeatures) {
+        removeRedundantFeatures(dataset);
+    }
+}/*finishDataset(FEASTDataset*,FSOptions*)*/
+
+FEASTDataset* createFEASTDataset(uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, FSOptions *options) {
+    FEASTDataset *dataset = (FEASTDataset *) checkedCalloc(1,sizeof(FEASTDataset));
+    FSOptions storageOptions;
+
+    /*the dataset always owns compact copies of the columns*/
+    initialiseFSOptions(&storageOptions);
+    storageOptions.compactStorage = 1;
+    storageOptions.bitmapIndex = (options != NULL) && options->bitmapIndex;
+    storageOptions.deduplicateRows = (options != NULL) && options->deduplicateRows;
+
+    createColumnSet(noOfSamples, noOfFeatures, featureMatrix, classColumn, &storageOptions, &(dataset->set));
+    finishDataset(dataset, options);
+
+    return dataset;
+}/*createFEASTDataset(uint,uint,uint[][],uint[],FSOptions*)*/
+
+FEASTDataset* discFEASTDataset(uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, FSOptions *options) {
+    FEASTDataset *dataset = (FEASTDataset *) checkedCalloc(1,sizeof(FEASTDataset));
+
+    normaliseColumnSet(noOfSamples, noOfFeatures, featureMatrix, classColumn, &(dataset->set));
+    if ((options != NULL) && options->deduplicateRows) {
+        deduplicateColumnSet(&(dataset->set));
+    }
+    if ((options != NULL) && options->bitmapIndex) {
+        buildColumnBitmaps(&(dataset->set));
+    }
+    finishDataset(dataset, options);
+
+    return dataset;
+}/*discFEASTDataset(uint,uint,double[][],double[],FSOptions*)*/
+
+FEASTDataset* sparseFEASTDataset(uint noOfSamples, uint noOfFeatures, uint *columnStarts, uint *rowIndices, uint *values, uint *classColumn, FSOptions *options) {
+    FEASTDataset *dataset = (FEASTDataset *) checkedCalloc(1,sizeof(FEASTDataset));
+
+    createSparseColumnSet(noOfSamples, noOfFeatures, columnStarts, rowIndices, values, classColumn, options, &(dataset->set));
+    finishDataset(dataset, options);
+
+    return dataset;
+}/*sparseFEASTDataset(uint,uint,uint[],uint[],uint[],uint[],FSOptions*)*/
+
+void freeFEASTDataset(FEASTDataset *dataset) {
+    if (dataset != NULL) {
+        if (dataset->featureIndices != NULL) {
+            /*the search set shares its columns with the full set*/
+            FREE_FUNC(dataset->searchSet.features);
+            FREE_FUNC(dataset->searchSet.classMI);
+            FREE_FUNC(dataset->searchSet.entropies);
+            FREE_FUNC(dataset->featureIndices);
+            dataset->featureIndices = NULL;
+        }
+        freeColumnSet(&(dataset->set));
+        if (dataset->mapping != NULL) {
+            unmapDataset(dataset);
+        }
+        FREE_FUNC(dataset);
+    }
+}/*freeFEASTDataset(FEASTDataset*)*/
+
+uint datasetNoOfSamples(FEASTDataset *dataset) {
+    return countedLength(&(dataset->set.classColumn), dataset->set.noOfSamples);
+}/*datasetNoOfSamples(FEASTDataset*)*/
+
+uint datasetNoOfRows(FEASTDataset *dataset) {
+    return dataset->set.noOfSamples;
+}/*datasetNoOfRows(FEASTDataset*)*/
+
+uint datasetNoOfFeatures(FEASTDataset *dataset) {
+    return dataset->set.noOfFeatures;
+}/*datasetNoOfFeatures(FEASTDataset*)*/
+
+int datasetNumStates(FEASTDataset *dataset, uint feature) {
+    return dataset->set.features[feature].numStates;
+}/*datasetNumStates(FEASTDataset*,uint)*/
+
+double datasetEntropy(FEASTDataset *dataset, uint feature) {
+    return dataset->set.entropies[feature];
+}/*datasetEntropy(FEASTDataset*,uint)*/
+
+double datasetClassEntropy(FEASTDataset *dataset) {
+    return dataset->set.entropies[dataset->set.noOfFeatures];
+}/*datasetClassEntropy(FEASTDataset*)*/
+
+double datasetClassMI(FEASTDataset *dataset, uint feature) {
+    return dataset->set.classMI[feature];
+}/*datasetClassMI(FEASTDataset*,uint)*/
+
+FSColumnSet* searchColumnSet(FEASTDataset *dataset) {
+    return dataset->featureIndices != NULL ? &(dataset->searchSet) : &(dataset->set);
+}/*searchColumnSet(FEASTDataset*)*/
+
+uint searchLength(FEASTDataset *dataset, uint k) {
+    uint noOfFeatures = searchColumnSet(dataset)->noOfFeatures;
+    return k < noOfFeatures ? k : noOfFeatures;
+}/*searchLength(FEASTDataset*,uint)*/
+
+uint* restoreFeatureIndices(FEASTDataset *dataset, uint k, uint *outputFeatures, double *featureScores) {
+    uint searched = searchLength(dataset, k);
+    uint next = 0, kept = 0;
+    uint i;
+
+    if (dataset->featureIndices == NULL) {
+        return outputFeatures;
+    }
+
+    for (i = 0; i < searched; i++) {
+        outputFeatures[i] = dataset->featureIndices[outputFeatures[i]];
+    }
+
+    /*the removed features are the gaps in featureIndices*/
+    for (i = searched; i < k; i++) {
+        while ((kept < dataset->searchSet.noOfFeatures) && (dataset->featureIndices[kept] == next)) {
+            kept++;
+            next++;
+        }
+        outputFeatures[i] = next;
+        featureScores[i] = 0.0;
+        next++;
+    }
+
+    return outputFeatures;
+}/*restoreFeatureIndices(FEASTDataset*,uint,uint[],double[])*/
+
+int* restoreConditionalIndices(FEASTDataset *dataset, uint k, int *outputFeatures, double *featureScores) {
+    uint searched = searchLength(dataset, k);
+    uint i;
+
+    if (dataset->featureIndices == NULL) {
+        return outputFeatures;
+    }
+
+    for (i = 0; i < searched; i++) {
+        if (outputFeatures[i] != -1) {
+            outputFeatures[i] = dataset->featureIndices[outputFeatures[i]];
+        }
+    }
+
+    for (i = searched; i < k; i++) {
+        outputFeatures[i] = -1;
+        featureScores[i] = 0.0;
+    }
+
+    return outputFeatures;
+}/*restoreConditionalIndices(FEASTDataset*,uint,int[],double[])*/
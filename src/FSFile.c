@@ -0,0 +1,522 @@
+/*******************************************************************************
+** FSFile.c
+** Implements the FEAST column file writer and reader, and mapFEASTDataset
+** which points the columns of a FEASTDataset into a memory mapping of a
+** column file.
+**
+** Author: Adam Pocock
+** Created: 17/10/2026
+**
+** Part of the FEAture Selection Toolbox (FEAST), please reference
+** "Conditional Likelihood Maximisation: A Unifying Framework for Information
+** Theoretic Feature Selection"
+** G. Brown, A. Pocock, M.-J. Zhao, M. Lujan
+** Journal of Machine Learning Research (JMLR), 2012
+**
+** Please check www.github.com/Craigacp/FEAST for updates.
+** 
+** Copyright (c) 2010-2017, A. Pocock, G. Brown, The University of Manchester
+** All rights reserved.
+** 
+** Redistribution and use in source and binary forms, with or without modification,
+** are permitted provided that the following conditions are met:
+** 
+**   - Redistributions of source code must retain the above copyright notice, this 
+**     list of conditions and the following disclaimer.
+**   - Redistributions in binary form must reproduce the above copyright notice, 
+**     this list of conditions and the following disclaimer in the documentation 
+**     and/or other materials provided with the distribution.
+**   - Neither the name of The University of Manchester nor the names of its 
+**     contributors may be used to endorse or promote products derived from this 
+**     software without specific prior written permission.
+** 
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+** ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+** ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+** (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+** LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+** ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+** SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+*******************************************************************************/
+
+
+/*mmap and posix_madvise need the POSIX definitions, and large files a 64 bit off_t*/
+#define _POSIX_C_SOURCE 200112L
+#define _FILE_OFFSET_BITS 64
+
+#include "FEAST/FSFile.h"
+#include "FEAST/FSToolbox.h"
+#include "FSInternal.h"
+
+#include <stdio.h>
+
+#ifndef _WIN32
+  #define FS_MEMORY_MAP
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif
+
+/* MIToolbox includes */
+#include "MIToolbox/ArrayOperations.h"
+
+/*the magic string, version, noOfSamples, noOfFeatures and alignment*/
+#define FS_FILE_MAGIC "FEASTCOL"
+#define FS_FILE_MAGIC_LENGTH 8
+#define FS_FILE_HEADER_FIELDS 4
+
+struct FEASTFileWriter {
+    FILE *file;
+    uint noOfSamples;
+    uint noOfFeatures;
+    uint noOfColumns;
+    /*width and numStates of each column, as they are written in the header*/
+    uint *columnInfo;
+    int failed;
+};
+
+/*******************************************************************************
+** alignedSize() rounds size up to a multiple of FEAST_FILE_ALIGNMENT.
+**
+** headerSize() is the number of bytes before the first column of a file with
+** noOfFeatures features, and columnSize() the bytes taken by one column.
+*******************************************************************************/
+static size_t alignedSize(size_t size) {
+    return ((size + FEAST_FILE_ALIGNMENT - 1) / FEAST_FILE_ALIGNMENT) * FEAST_FILE_ALIGNMENT;
+}/*alignedSize(size_t)*/
+
+static size_t headerSize(uint noOfFeatures) {
+    return alignedSize(FS_FILE_MAGIC_LENGTH + sizeof(uint) * (FS_FILE_HEADER_FIELDS + 2 * ((size_t) noOfFeatures + 1)));
+}/*headerSize(uint)*/
+
+static size_t columnSize(uint noOfSamples, int width) {
+    return alignedSize((size_t) noOfSamples * width);
+}/*columnSize(uint,int)*/
+
+FEASTFileWriter* createFEASTFile(const char *fileName, uint noOfSamples, uint noOfFeatures) {
+    FEASTFileWriter *writer;
+    FILE *file = fopen(fileName, "wb");
+
+    if (file == NULL) {
+        return NULL;
+    }
+
+    writer = (FEASTFileWriter *) checkedCalloc(1,sizeof(FEASTFileWriter));
+    writer->file = file;
+    writer->noOfSamples = noOfSamples;
+    writer->noOfFeatures = noOfFeatures;
+    writer->noOfColumns = 0;
+    writer->columnInfo = (uint *) checkedCalloc(2 * ((size_t) noOfFeatures + 1),sizeof(uint));
+    writer->failed = fseek(file, (long) headerSize(noOfFeatures), SEEK_SET) != 0;
+
+    return writer;
+}/*createFEASTFile(const char*,uint,uint)*/
+
+int appendFEASTColumn(FEASTFileWriter *writer, uint *column) {
+    unsigned char buffer[FS_BLOCK_SIZE * sizeof(uint)];
+    uint noOfSamples = writer->noOfSamples;
+    int numStates, width;
+    size_t padding;
+    uint start, length, i;
+
+    if (writer->failed || (writer->noOfColumns > writer->noOfFeatures)) {
+        writer->failed = 1;
+        return -1;
+    }
+
+    numStates = maxState(column, noOfSamples);
+    width = columnWidth(numStates);
+    writer->columnInfo[2 * writer->noOfColumns] = width;
+    writer->columnInfo[2 * writer->noOfColumns + 1] = numStates;
+
+    for (start = 0; start < noOfSamples; start += FS_BLOCK_SIZE) {
+        length = noOfSamples - start < FS_BLOCK_SIZE ? noOfSamples - start : FS_BLOCK_SIZE;
+        if (width == sizeof(unsigned char)) {
+            for (i = 0; i < length; i++) {
+                buffer[i] = (unsigned char) column[start + i];
+            }
+        } else if (width == sizeof(unsigned short)) {
+            for (i = 0; i < length; i++) {
+                ((unsigned short *) buffer)[i] = (unsigned short) column[start + i];
+            }
+        } else {
+            memcpy(buffer, column + start, sizeof(uint) * length);
+        }
+        if (fwrite(buffer, width, length, writer->file) != length) {
+            writer->failed = 1;
+            return -1;
+        }
+    }
+
+    /*pad the column out to the alignment*/
+    memset(buffer, 0, sizeof(buffer));
+    padding = columnSize(noOfSamples,width) - (size_t) noOfSamples * width;
+    while (padding > 0) {
+        length = padding < sizeof(buffer) ? (uint) padding : (uint) sizeof(buffer);
+        if (fwrite(buffer, 1, length, writer->file) != length) {
+            writer->failed = 1;
+            return -1;
+        }
+        padding -= length;
+    }
+
+    writer->noOfColumns++;
+
+    return 0;
+}/*appendFEASTColumn(FEASTFileWriter*,uint[])*/
+
+int closeFEASTFile(FEASTFileWriter *writer) {
+    uint header[FS_FILE_HEADER_FIELDS];
+    size_t noOfInfo = 2 * ((size_t) writer->noOfFeatures + 1);
+    int failed = writer->failed || (writer->noOfColumns != writer->noOfFeatures + 1);
+
+    header[0] = FEAST_FILE_VERSION;
+    header[1] = writer->noOfSamples;
+    header[2] = writer->noOfFeatures;
+    header[3] = FEAST_FILE_ALIGNMENT;
+
+    if (!failed) {
+        failed = (fseek(writer->file, 0, SEEK_SET) != 0)
+              || (fwrite(FS_FILE_MAGIC, 1, FS_FILE_MAGIC_LENGTH, writer->file) != FS_FILE_MAGIC_LENGTH)
+              || (fwrite(header, sizeof(uint), FS_FILE_HEADER_FIELDS, writer->file) != FS_FILE_HEADER_FIELDS)
+              || (fwrite(writer->columnInfo, sizeof(uint), noOfInfo, writer->file) != noOfInfo);
+    }
+
+    if (fclose(writer->file) != 0) {
+        failed = 1;
+    }
+
+    FREE_FUNC(writer->columnInfo);
+    FREE_FUNC(writer);
+    writer = NULL;
+
+    return failed ? -1 : 0;
+}/*closeFEASTFile(FEASTFileWriter*)*/
+
+int writeFEASTFile(const char *fileName, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn) {
+    FEASTFileWriter *writer = createFEASTFile(fileName, noOfSamples, noOfFeatures);
+    uint i;
+
+    if (writer == NULL) {
+        return -1;
+    }
+
+    for (i = 0; i < noOfFeatures; i++) {
+        appendFEASTColumn(writer, featureMatrix[i]);
+    }
+    appendFEASTColumn(writer, classColumn);
+
+    return closeFEASTFile(writer);
+}/*writeFEASTFile(const char*,uint,uint,uint[][],uint[])*/
+
+/*******************************************************************************
+** validNumStates() checks the number of states stored for a column of width
+** bytes is one the kernels can index, between 1 and the values of the width.
+**
+** checkColumnValues() returns 0 if every value of a column is less than its
+** number of states, and -1 otherwise, as the kernels index their tables by
+** the values.
+*******************************************************************************/
+static int validNumStates(uint width, uint numStates) {
+    if ((numStates == 0) || (numStates > INT_MAX)) {
+        return 0;
+    }
+
+    return (width >= sizeof(uint)) || (numStates <= (1U << (8 * width)));
+}/*validNumStates(uint,uint)*/
+
+static int checkColumnValues(FSColumn *column, int vectorLength) {
+    int block[FS_BLOCK_SIZE];
+    int start, length, i;
+
+    for (start = 0; start < vectorLength; start += FS_BLOCK_SIZE) {
+        length = vectorLength - start < FS_BLOCK_SIZE ? vectorLength - start : FS_BLOCK_SIZE;
+        loadColumnBlock(column,start,length,block);
+        for (i = 0; i < length; i++) {
+            /*a uint above INT_MAX loads as a negative int*/
+            if ((block[i] < 0) || (block[i] >= column->numStates)) {
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}/*checkColumnValues(FSColumn*,int)*/
+
+/*******************************************************************************
+** readFileHeader() reads and checks the header of a column file, returning
+** the width and numStates of every column in a newly allocated array, or NULL
+** if it isn't a valid column file of at least fileSize bytes.
+*******************************************************************************/
+static uint* readFileHeader(FILE *file, size_t fileSize, uint *noOfSamples, uint *noOfFeatures) {
+    char magic[FS_FILE_MAGIC_LENGTH];
+    uint header[FS_FILE_HEADER_FIELDS];
+    uint *columnInfo;
+    size_t noOfInfo, expectedSize;
+    uint i;
+
+    if ((fread(magic, 1, FS_FILE_MAGIC_LENGTH, file) != FS_FILE_MAGIC_LENGTH)
+        || (memcmp(magic, FS_FILE_MAGIC, FS_FILE_MAGIC_LENGTH) != 0)
+        || (fread(header, sizeof(uint), FS_FILE_HEADER_FIELDS, file) != FS_FILE_HEADER_FIELDS)
+        || (header[0] != FEAST_FILE_VERSION) || (header[3] != FEAST_FILE_ALIGNMENT)) {
+        return NULL;
+    }
+
+    /*the column information has to fit in the file before it is allocated*/
+    if ((header[1] > INT_MAX) || (header[2] > INT_MAX) || ((size_t) header[2] + 1 > fileSize / (2 * sizeof(uint)))) {
+        return NULL;
+    }
+
+    *noOfSamples = header[1];
+    *noOfFeatures = header[2];
+    noOfInfo = 2 * ((size_t) header[2] + 1);
+    columnInfo = (uint *) checkedCalloc(noOfInfo,sizeof(uint));
+
+    if (fread(columnInfo, sizeof(uint), noOfInfo, file) != noOfInfo) {
+        FREE_FUNC(columnInfo);
+        return NULL;
+    }
+
+    expectedSize = headerSize(*noOfFeatures);
+    for (i = 0; i <= *noOfFeatures; i++) {
+        if (((columnInfo[2*i] != sizeof(unsigned char)) && (columnInfo[2*i] != sizeof(unsigned short)) && (columnInfo[2*i] != sizeof(uint)))
+            || !validNumStates(columnInfo[2*i], columnInfo[2*i + 1])) {
+            FREE_FUNC(columnInfo);
+            return NULL;
+        }
+        expectedSize += columnSize(*noOfSamples, columnInfo[2*i]);
+    }
+
+    if (fileSize < expectedSize) {
+        FREE_FUNC(columnInfo);
+        return NULL;
+    }
+
+    return columnInfo;
+}/*readFileHeader(FILE*,size_t,uint*,uint*)*/
+
+FEASTColumns* readFEASTFile(const char *fileName) {
+    unsigned char buffer[FS_BLOCK_SIZE * sizeof(uint)];
+    FEASTColumns *columns;
+    FILE *file;
+    uint *columnInfo, *outputVector;
+    uint noOfSamples, noOfFeatures;
+    size_t fileSize, padding;
+    uint start, length, width, i, j;
+    int failed = 0;
+
+    file = fopen(fileName, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    columnInfo = readFileHeader(file, fileSize, &noOfSamples, &noOfFeatures);
+    if ((columnInfo == NULL) || (fseek(file, (long) headerSize(noOfFeatures), SEEK_SET) != 0)) {
+        if (columnInfo != NULL) {
+            FREE_FUNC(columnInfo);
+        }
+        fclose(file);
+        return NULL;
+    }
+
+    /*the class is column noOfFeatures of the block*/
+    columns = (FEASTColumns *) checkedCalloc(1,sizeof(FEASTColumns));
+    columns->noOfSamples = noOfSamples;
+    columns->noOfFeatures = noOfFeatures;
+    columns->featureMatrix = (uint **) checkedCalloc(noOfFeatures + 1,sizeof(uint *));
+    columns->featureMatrix[0] = (uint *) checkedCalloc(((size_t) noOfFeatures + 1) * noOfSamples,sizeof(uint));
+    for (i = 1; i <= noOfFeatures; i++) {
+        columns->featureMatrix[i] = columns->featureMatrix[i-1] + noOfSamples;
+    }
+    columns->classColumn = columns->featureMatrix[noOfFeatures];
+
+    for (i = 0; (i <= noOfFeatures) && !failed; i++) {
+        width = columnInfo[2*i];
+        outputVector = columns->featureMatrix[i];
+        for (start = 0; (start < noOfSamples) && !failed; start += FS_BLOCK_SIZE) {
+            length = noOfSamples - start < FS_BLOCK_SIZE ? noOfSamples - start : FS_BLOCK_SIZE;
+            if (width == sizeof(uint)) {
+                failed = fread(outputVector + start, sizeof(uint), length, file) != length;
+            } else if (fread(buffer, width, length, file) != length) {
+                failed = 1;
+            } else if (width == sizeof(unsigned char)) {
+                for (j = 0; j < length; j++) {
+                    outputVector[start + j] = buffer[j];
+                }
+            } else {
+                for (j = 0; j < length; j++) {
+                    outputVector[start + j] = ((unsigned short *) buffer)[j];
+                }
+            }
+        }
+        padding = columnSize(noOfSamples,width) - (size_t) noOfSamples * width;
+        if (!failed && (padding > 0)) {
+            failed = fseek(file, (long) padding, SEEK_CUR) != 0;
+        }
+    }
+
+    fclose(file);
+    FREE_FUNC(columnInfo);
+    columnInfo = NULL;
+
+    if (failed) {
+        freeFEASTColumns(columns);
+        columns = NULL;
+    }
+
+    return columns;
+}/*readFEASTFile(const char*)*/
+
+void freeFEASTColumns(FEASTColumns *columns) {
+    if (columns != NULL) {
+        FREE_FUNC(columns->featureMatrix[0]);
+        FREE_FUNC(columns->featureMatrix);
+        FREE_FUNC(columns);
+    }
+}/*freeFEASTColumns(FEASTColumns*)*/
+
+int mapColumnFile(const char *fileName, FSColumnSet *set, void **mapping, size_t *mappingSize) {
+    FSColumn *column;
+    FILE *file;
+    uint *columnInfo;
+    uint noOfSamples, noOfFeatures;
+    size_t fileSize, position;
+    char *fileData;
+    uint i;
+#ifdef FS_MEMORY_MAP
+    struct stat fileStatus;
+    long pageSize = sysconf(_SC_PAGESIZE);
+    size_t pageStart;
+#endif
+
+    file = fopen(fileName, "rb");
+    if (file == NULL) {
+        return -1;
+    }
+
+#ifdef FS_MEMORY_MAP
+    if (fstat(fileno(file), &fileStatus) != 0) {
+        fclose(file);
+        return -1;
+    }
+    fileSize = fileStatus.st_size;
+#else
+    fseek(file, 0, SEEK_END);
+    fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+#endif
+
+    columnInfo = readFileHeader(file, fileSize, &noOfSamples, &noOfFeatures);
+    if (columnInfo == NULL) {
+        fclose(file);
+        return -1;
+    }
+
+#ifdef FS_MEMORY_MAP
+    fileData = (char *) mmap(NULL, fileSize, PROT_READ, MAP_SHARED, fileno(file), 0);
+    if (fileData == (char *) MAP_FAILED) {
+        fileData = NULL;
+    }
+#else
+    fileData = (char *) checkedCalloc(fileSize,sizeof(char));
+    if ((fseek(file, 0, SEEK_SET) != 0) || (fread(fileData, 1, fileSize, file) != fileSize)) {
+        FREE_FUNC(fileData);
+        fileData = NULL;
+    }
+#endif
+    fclose(file);
+
+    if (fileData == NULL) {
+        FREE_FUNC(columnInfo);
+        return -1;
+    }
+
+    set->noOfSamples = noOfSamples;
+    set->noOfFeatures = noOfFeatures;
+    set->features = (FSColumn *) checkedCalloc(noOfFeatures,sizeof(FSColumn));
+    set->storage = NULL;
+    set->bitmapStorage = NULL;
+    set->classMI = NULL;
+    set->entropies = NULL;
+    set->rowCounts = NULL;
+
+    /*the class is treated as column noOfFeatures*/
+    position = headerSize(noOfFeatures);
+    for (i = 0; i <= noOfFeatures; i++) {
+        column = i < noOfFeatures ? set->features + i : &(set->classColumn);
+        column->data = fileData + position;
+        column->width = columnInfo[2*i];
+        column->numStates = columnInfo[2*i + 1];
+        column->bits = NULL;
+        column->rowIndices = NULL;
+        column->noOfEntries = noOfSamples;
+        column->stateCounts = NULL;
+        column->rowCounts = NULL;
+        position += columnSize(noOfSamples, column->width);
+        if (checkColumnValues(column, noOfSamples) != 0) {
+            FREE_FUNC(set->features);
+            FREE_FUNC(columnInfo);
+            set->features = NULL;
+            unmapColumnFile(fileData, fileSize);
+            return -1;
+        }
+    }
+
+#ifdef FS_MEMORY_MAP
+    /*the features are streamed in index order, and the class is read against every one of them*/
+    position = headerSize(noOfFeatures);
+    posix_madvise(fileData + position, (char *) set->classColumn.data - (fileData + position), POSIX_MADV_SEQUENTIAL);
+    pageStart = (((char *) set->classColumn.data - fileData) / pageSize) * pageSize;
+    posix_madvise(fileData + pageStart, fileSize - pageStart, POSIX_MADV_WILLNEED);
+#endif
+
+    FREE_FUNC(columnInfo);
+    columnInfo = NULL;
+
+    *mapping = fileData;
+    *mappingSize = fileSize;
+
+    return 0;
+}/*mapColumnFile(const char*,FSColumnSet*,void**,size_t*)*/
+
+void unmapColumnFile(void *mapping, size_t mappingSize) {
+#ifdef FS_MEMORY_MAP
+    munmap(mapping, mappingSize);
+#else
+    FREE_FUNC(mapping);
+#endif
+}/*unmapColumnFile(void*,size_t)*/
+
+FEASTDataset* mapFEASTDataset(const char *fileName, FSOptions *options) {
+    FEASTDataset *dataset = (FEASTDataset *) checkedCalloc(1,sizeof(FEASTDataset));
+
+    if (mapColumnFile(fileName, &(dataset->set), &(dataset->mapping), &(dataset->mappingSize)) != 0) {
+        FREE_FUNC(dataset);
+        return NULL;
+    }
+
+    if ((options != NULL) && options->deduplicateRows) {
+        deduplicateColumnSet(&(dataset->set));
+    }
+    if ((options != NULL) && options->bitmapIndex) {
+        buildColumnBitmaps(&(dataset->set));
+    }
+    finishDataset(dataset, options);
+
+    return dataset;
+}/*mapFEASTDataset(const char*,FSOptions*)*/
+
+void unmapDataset(FEASTDataset *dataset) {
+    unmapColumnFile(dataset->mapping, dataset->mappingSize);
+    dataset->mapping = NULL;
+    dataset->mappingSize = 0;
+}/*unmapDataset(FEASTDataset*)*/
@@ -0,0 +1,137 @@
+/*******************************************************************************
+** FSHeap.c
+** Implements the max-heap of candidate features used by the lazy JMI and DISR
+** searches. Each candidate is keyed by an optimistic bound on its score, and
+** ties are broken towards the lower feature index like BETTER_CANDIDATE.
+**
+** Author: Adam Pocock
+** Created: 17/10/2026
+**
+** Part of the FEAture Selection Toolbox (FEAST), please reference
+** "Conditional Likelihood Maximisation: A Unifying Framework for Information
+** Theoretic Feature Selection"
+** G. Brown, A. Pocock, M.-J. Zhao, M. Lujan
+** Journal of Machine Learning Research (JMLR), 2012
+**
+** Please check www.github.com/Craigacp/FEAST for updates.
+** 
+** Copyright (c) 2010-2017, A. Pocock, G. Brown, The University of Manchester
+** All rights reserved.
+** 
+** Redistribution and use in source and binary forms, with or without modification,
+** are permitted provided that the following conditions are met:
+** 
+**   - Redistributions of source code must retain the above copyright notice, this 
+**     list of conditions and the following disclaimer.
+**   - Redistributions in binary form must reproduce the above copyright notice, 
+**     this list of conditions and the following disclaimer in the documentation 
+**     and/or other materials provided with the distribution.
+**   - Neither the name of The University of Manchester nor the names of its 
+**     contributors may be used to endorse or promote products derived from this 
+**     software without specific prior written permission.
+** 
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+** ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+** ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+** (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+** LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+** ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+** SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+*******************************************************************************/
+
+
+#include "FEAST/FSToolbox.h"
+#include "FSInternal.h"
+
+static void swapCandidates(FSHeap *heap, int first, int second) {
+    double key = heap->keys[first];
+    int index = heap->indices[first];
+
+    heap->keys[first] = heap->keys[second];
+    heap->indices[first] = heap->indices[second];
+    heap->keys[second] = key;
+    heap->indices[second] = index;
+}/*swapCandidates(FSHeap*,int,int)*/
+
+void createHeap(int capacity, FSHeap *heap) {
+    heap->size = 0;
+    heap->keys = (double *) checkedCalloc(capacity,sizeof(double));
+    heap->indices = (int *) checkedCalloc(capacity,sizeof(int));
+}/*createHeap(int,FSHeap*)*/
+
+void pushHeap(FSHeap *heap, double key, int index) {
+    int position = heap->size;
+    int parent;
+
+    heap->keys[position] = key;
+    heap->indices[position] = index;
+    heap->size++;
+
+    while (position > 0) {
+        parent = (position - 1) / 2;
+        if (BETTER_CANDIDATE(heap->keys[position],heap->indices[position],heap->keys[parent],heap->indices[parent])) {
+            swapCandidates(heap, position, parent);
+            position = parent;
+        } else {
+            break;
+        }
+    }/*while above its parent*/
+}/*pushHeap(FSHeap*,double,int)*/
+
+/*******************************************************************************
+** siftDown() moves the candidate at position down until neither child is a
+** better candidate.
+*******************************************************************************/
+static void siftDown(FSHeap *heap, int position) {
+    int child, best;
+
+    for (;;) {
+        best = position;
+        child = 2 * position + 1;
+        if ((child < heap->size) && BETTER_CANDIDATE(heap->keys[child],heap->indices[child],heap->keys[best],heap->indices[best])) {
+            best = child;
+        }
+        child++;
+        if ((child < heap->size) && BETTER_CANDIDATE(heap->keys[child],heap->indices[child],heap->keys[best],heap->indices[best])) {
+            best = child;
+        }
+        if (best == position) {
+            break;
+        }
+        swapCandidates(heap, position, best);
+        position = best;
+    }/*while below a child*/
+}/*siftDown(FSHeap*,int)*/
+
+void buildHeap(FSHeap *heap) {
+    int position;
+
+    /*the leaves are already heaps, so each parent is sifted down from the last*/
+    for (position = heap->size / 2 - 1; position >= 0; position--) {
+        siftDown(heap, position);
+    }
+}/*buildHeap(FSHeap*)*/
+
+int popHeap(FSHeap *heap) {
+    int index = heap->indices[0];
+
+    heap->size--;
+    heap->keys[0] = heap->keys[heap->size];
+    heap->indices[0] = heap->indices[heap->size];
+    siftDown(heap, 0);
+
+    return index;
+}/*popHeap(FSHeap*)*/
+
+void freeHeap(FSHeap *heap) {
+    FREE_FUNC(heap->keys);
+    FREE_FUNC(heap->indices);
+
+    heap->keys = NULL;
+    heap->indices = NULL;
+    heap->size = 0;
+}/*freeHeap(FSHeap*)*/
@@ -0,0 +1,519 @@
+/*******************************************************************************
+** FSInternal.h
+** Shared helper functions used by the FEAST algorithms. These are not part of
+** the public API and may change between versions.
+**
+** Author: Adam Pocock
+** Created: 17/10/2026
+**
+** Part of the FEAture Selection Toolbox (FEAST), please reference
+** "Conditional Likelihood Maximisation: A Unifying Framework for Information
+** Theoretic Feature Selection"
+** G. Brown, A. Pocock, M.-J. Zhao, M. Lujan
+** Journal of Machine Learning Research (JMLR), 2012
+**
+** Please check www.github.com/Craigacp/FEAST for updates.
+** 
+** Copyright (c) 2010-2017, A. Pocock, G. Brown, The University of Manchester
+** All rights reserved.
+** 
+** Redistribution and use in source and binary forms, with or without modification,
+** are permitted provided that the following conditions are met:
+** 
+**   - Redistributions of source code must retain the above copyright notice, this 
+**     list of conditions and the following disclaimer.
+**   - Redistributions in binary form must reproduce the above copyright notice, 
+**     this list of conditions and the following disclaimer in the documentation 
+**     and/or other materials provided with the distribution.
+**   - Neither the name of The University of Manchester nor the names of its 
+**     contributors may be used to endorse or promote products derived from this 
+**     software without specific prior written permission.
+** 
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+** ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+** ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+** (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+** LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+** ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+** SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+*******************************************************************************/
+
+
+#ifndef __FSInternal_H
+#define __FSInternal_H
+
+#include <limits.h>
+#include <stddef.h>
+
+#include "MIToolbox/MIToolbox.h"
+#include "FEAST/FSOptions.h"
+#include "FEAST/FSDataset.h"
+#include "FEAST/FSBatch.h"
+
+/*number of candidate features handed to a thread at a time*/
+#define FS_CHUNK_SIZE 16
+
+/*number of samples widened at a time by the column kernels*/
+#define FS_BLOCK_SIZE 256
+
+/*the relative slack added to the score bounds of the lazy searches, covering rounding in the terms*/
+#define FS_BOUND_TOLERANCE 1e-9
+
+/*the word used by the bitmap index, and the number of bits in it*/
+typedef unsigned long FSWord;
+#define FS_WORD_BITS ((int) (sizeof(FSWord) * CHAR_BIT))
+
+/*columns with at most this many states get a bitmap index*/
+#define FS_BITMAP_MAX_STATES 16
+
+/*the bitmap kernel is used when the three way table has at most this many cells*/
+#define FS_BITMAP_MAX_CELLS 64
+
+/*bounds tableCountsLength() for a bitmap table, reached with a single class state*/
+#define FS_BITMAP_TABLE_COUNTS (3 * FS_BITMAP_MAX_CELLS + 3)
+
+/*******************************************************************************
+** FSColumn is a discrete column stored at the narrowest width which holds its
+** states, an unsigned char for up to 256 states, an unsigned short for up to
+** 65536, otherwise a uint. numStates is one more than the largest value, as
+** returned by maxState.
+**
+** bits is the bitmap index of the column, NULL if it hasn't been built. It
+** holds one bitset of bitmapWords(noOfSamples) words for each state, with
+** bit i of bitset v set if sample i has value v.
+**
+** A sparse column has rowIndices set, and stores only noOfEntries samples:
+** sample rowIndices[i] has the uint value ((uint *) data)[i], the row indices
+** are strictly increasing, and every other sample is zero. rowIndices is NULL
+** for dense columns.
+**
+** stateCounts holds the number of samples in each state, NULL if they haven't
+** been counted. The sparse kernels need it for a dense class column, as they
+** find the zero cells by subtracting from it.
+**
+** rowCounts is the number of samples each row stands for when duplicate rows
+** have been collapsed, and is shared by every column of the set. It is NULL
+** when each row is a single sample.
+*******************************************************************************/
+typedef struct FSColumn {
+    void *data;
+    int width;
+    int numStates;
+    FSWord *bits;
+    uint *rowIndices;
+    int noOfEntries;
+    int *stateCounts;
+    uint *rowCounts;
+} FSColumn;
+
+/*******************************************************************************
+** FSColumnSet is the column view of a dataset which the algorithms search
+** over. storage holds any compact copies of the columns, and is NULL if every
+** column is read in place from the caller's arrays. bitmapStorage holds the
+** bitmap indices, and is NULL if none were built. classMI and entropies are
+** caches of I(X_i;Y) and H(X_i) filled in by FEASTDatasets, entropies has the
+** class entropy in position noOfFeatures. Both are NULL if not cached.
+**
+** rowCounts holds the multiplicity of each row once duplicate rows have been
+** collapsed by deduplicateColumnSet(), and noOfSamples is then the number of
+** distinct rows. It is NULL if the rows haven't been collapsed.
+*******************************************************************************/
+typedef struct FSColumnSet {
+    uint noOfSamples;
+    uint noOfFeatures;
+    FSColumn *features;
+    FSColumn classColumn;
+    void *storage;
+    FSWord *bitmapStorage;
+    double *classMI;
+    double *entropies;
+    uint *rowCounts;
+} FSColumnSet;
+
+/*******************************************************************************
+** FEASTDataset is the preprocessed dataset behind the public handle in
+** FSDataset.h. Its column set owns compact copies of every column, and
+** caches the class MI and the entropy of each column.
+**
+** If the constant and duplicate features were removed, searchSet views the
+** remaining columns of set without owning any of them, and featureIndices
+** holds the index in set of each of its features. featureIndices is NULL if
+** no features were removed, and the search runs over set itself.
+**
+** mapping is the memory mapping of the column file the columns are read from
+** for a dataset built by mapFEASTDataset(), and NULL otherwise.
+*******************************************************************************/
+struct FEASTDataset {
+    FSColumnSet set;
+    FSColumnSet searchSet;
+    uint *featureIndices;
+    void *mapping;
+    size_t mappingSize;
+};
+
+/*******************************************************************************
+** finishDataset() fills the caches of a newly built dataset and removes the
+** redundant features if the options ask for it.
+**
+** unmapDataset() releases the mapping of a dataset built by
+** mapFEASTDataset().
+*******************************************************************************/
+void finishDataset(FEASTDataset *dataset, FSOptions *options);
+void unmapDataset(FEASTDataset *dataset);
+
+/*******************************************************************************
+** mapColumnFile() maps a column file and builds a column set which reads
+** every column in place from the mapping. Returns 0 on success, and -1 if the
+** file can't be opened or isn't a valid column file, including one holding
+** a value which isn't less than its column's numStates. Every value is
+** checked as the file is loaded, as the kernels index their tables by them.
+** The mapping must be released with unmapColumnFile() once the set has been
+** freed.
+*******************************************************************************/
+int mapColumnFile(const char *fileName, FSColumnSet *set, void **mapping, size_t *mappingSize);
+void unmapColumnFile(void *mapping, size_t mappingSize);
+
+/*******************************************************************************
+** searchColumnSet() returns the column set the dataset* algorithms search
+** over, and searchLength() returns the number of features to select from it,
+** which is k unless fewer features remain.
+**
+** restoreFeatureIndices() maps the features selected from the search set
+** back to the dataset's indices. If k is more than the number of features
+** searched, the remaining positions are filled with the removed features in
+** index order with a score of 0. restoreConditionalIndices() does the same
+** for CondMI's int outputs, filling the remaining positions with -1.
+*******************************************************************************/
+FSColumnSet* searchColumnSet(FEASTDataset *dataset);
+uint searchLength(FEASTDataset *dataset, uint k);
+uint* restoreFeatureIndices(FEASTDataset *dataset, uint k, uint *outputFeatures, double *featureScores);
+int* restoreConditionalIndices(FEASTDataset *dataset, uint k, int *outputFeatures, double *featureScores);
+
+/*******************************************************************************
+** BETTER_CANDIDATE is true if the candidate (score,index) beats the current
+** best (bestScore,bestIndex). Ties are broken towards the lower feature index,
+** which matches the order of the serial search, so the argmax is the same
+** no matter how the candidates are split across threads.
+*******************************************************************************/
+#define BETTER_CANDIDATE(score,index,bestScore,bestIndex) (((score) > (bestScore)) || (((score) == (bestScore)) && ((index) < (bestIndex))))
+
+/*******************************************************************************
+** numberOfThreads() returns the number of threads to use given the options,
+** options may be NULL. Returns 1 if FEAST was compiled without OpenMP.
+*******************************************************************************/
+int numberOfThreads(FSOptions *options);
+
+/*******************************************************************************
+** threadIndex() returns the index of the calling thread in the current
+** parallel region, in the range [0,numberOfThreads).
+*******************************************************************************/
+int threadIndex(void);
+
+/*******************************************************************************
+** createColumnSet() builds the column view of a uint dataset. If
+** options->compactStorage is set every column is copied at its narrowest
+** width, otherwise they are read in place. If options->bitmapIndex is set the
+** bitmap indices are built as well. tryCreateColumnSet() does the same, but
+** returns FS_ERROR_MEMORY with nothing allocated rather than exiting if the
+** column array or the compact copies can't be allocated, and FS_OK otherwise.
+**
+** normaliseColumnSet() normalises a double dataset as normaliseArray does,
+** storing every column at its narrowest width.
+**
+** createSparseColumnSet() builds the column view of a dataset whose features
+** are in compressed sparse column form, copying them into storage. The class
+** is stored densely with its state counts.
+**
+** deduplicateColumnSet() collapses the identical rows (features and class)
+** of a dense set into one row each, weighted by its number of samples. The
+** distinct rows keep the order of their first sample, so every count table
+** is filled in the same order and gives the same values as the full set.
+** The set is left unchanged if there are no duplicate rows or the memory for
+** the copy isn't available, and any bitmap index is dropped as it can't
+** weight the rows. Called by createColumnSet() when options->deduplicateRows
+** is set.
+**
+** freeColumnSet() frees the column array, any compact copies and any bitmap
+** indices.
+*******************************************************************************/
+void createColumnSet(uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, FSOptions *options, FSColumnSet *set);
+int tryCreateColumnSet(uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, FSOptions *options, FSColumnSet *set);
+void normaliseColumnSet(uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, FSColumnSet *set);
+void createSparseColumnSet(uint noOfSamples, uint noOfFeatures, uint *columnStarts, uint *rowIndices, uint *values, uint *classColumn, FSOptions *options, FSColumnSet *set);
+void deduplicateColumnSet(FSColumnSet *set);
+void freeColumnSet(FSColumnSet *set);
+
+/*******************************************************************************
+** columnWidth() returns the narrowest width in bytes which holds numStates
+** states.
+*******************************************************************************/
+int columnWidth(int numStates);
+
+/*******************************************************************************
+** loadColumnBlock() widens samples [start,start+length) of a column into
+** block, and addColumnBlock() adds them scaled by multiplier, so a joint
+** state index is built up one column at a time. length is at most
+** FS_BLOCK_SIZE. Sparse columns are expanded, filling in the zeros.
+**
+** unpackColumn() widens a whole column into a uint vector, and columnValue()
+** reads one sample of a dense column.
+**
+** countedLength() returns the number of samples the first vectorLength rows
+** of a column stand for.
+*******************************************************************************/
+void loadColumnBlock(FSColumn *column, int start, int length, int *block);
+void addColumnBlock(FSColumn *column, int start, int length, int multiplier, int *block);
+void unpackColumn(FSColumn *column, int vectorLength, uint *outputVector);
+int columnValue(FSColumn *column, int row);
+int countedLength(FSColumn *column, int vectorLength);
+
+/*******************************************************************************
+** bitmapWords() returns the number of words in one bitset of a column.
+**
+** buildColumnBitmap() fills bits with the bitmap index of a column with at
+** most FS_BITMAP_MAX_STATES states, and points column->bits at it. bits must
+** hold column->numStates * bitmapWords(vectorLength) zeroed words.
+**
+** buildColumnBitmaps() builds the bitmap index of every column in the set
+** with at most FS_BITMAP_MAX_STATES states, including the class. Sets whose
+** rows have been collapsed don't get one, and nor do sets whose index can't be
+** allocated.
+*******************************************************************************/
+int bitmapWords(int vectorLength);
+void buildColumnBitmap(FSColumn *column, int vectorLength, FSWord *bits);
+void buildColumnBitmaps(FSColumnSet *set);
+
+/*******************************************************************************
+** calculateClassMI() fills classMI with I(X_i;Y) for each feature i, using
+** the number of threads from options.
+**
+** calculateWeightedClassMI() is the same using the weighted mutual information.
+**
+** calculateEntropies() fills entropies with H(X_i) for each feature i, and
+** H(Y) in position noOfFeatures. Both copy from the set's cache when it is set.
+*******************************************************************************/
+void calculateClassMI(FSColumnSet *set, double *classMI, FSOptions *options);
+void calculateEntropies(FSColumnSet *set, double *entropies, FSOptions *options);
+void calculateWeightedClassMI(uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, double *classMI, FSOptions *options);
+
+/*******************************************************************************
+** rankByScore() returns a newly allocated array of the indices 0..length-1
+** sorted by descending score, ties broken towards the lower index. The lazy
+** searches use it to visit the most relevant candidates first.
+*******************************************************************************/
+int* rankByScore(double *scores, int length);
+
+/*******************************************************************************
+** FSHeap is a max-heap of candidate features keyed by an upper bound on their
+** score, with ties broken towards the lower index. The top candidate is
+** keys[0] and indices[0] when size is non-zero.
+**
+** createHeap() allocates space for capacity candidates, pushHeap() adds a
+** candidate, popHeap() removes the top candidate and returns its index, and
+** freeHeap() releases the heap. buildHeap() orders the first size keys and
+** indices written straight into the arrays in linear time, which is cheaper
+** than pushing them one at a time when the whole heap is refilled.
+*******************************************************************************/
+typedef struct FSHeap {
+    int size;
+    double *keys;
+    int *indices;
+} FSHeap;
+
+void createHeap(int capacity, FSHeap *heap);
+void pushHeap(FSHeap *heap, double key, int index);
+void buildHeap(FSHeap *heap);
+int popHeap(FSHeap *heap);
+void freeHeap(FSHeap *heap);
+
+/*******************************************************************************
+** JointStatistics holds the information theoretic quantities between a
+** selected feature A, a candidate feature B and the class C which the
+** forward searches need, all derived from the same contingency table.
+*******************************************************************************/
+typedef struct JointStatistics {
+    double mi;           /* I(A;B) */
+    double cmi;          /* I(A;B|C) */
+    double jointMI;      /* I(A,B;C) */
+    double classCMI;     /* I(B;C|A) */
+    double jointEntropy; /* H(A,B,C) */
+} JointStatistics;
+
+/*******************************************************************************
+** FSScratch holds the buffers the dense kernels count in, so a caller making
+** many calls can reuse them. For a first column of at most firstNumStates
+** states and a second of at most secondNumStates, with
+** pairCapacity = min(firstNumStates * secondNumStates, vectorLength),
+**
+**   stateMap holds firstNumStates * secondNumStates ints, and must be zeroed
+**     when it is first used, the kernels leave it zeroed,
+**   pairVector holds vectorLength + 2 * pairCapacity uints,
+**   jointCounts holds the larger of pairCapacity * classNumStates and
+**     firstNumStates * secondNumStates + firstNumStates + secondNumStates
+**     ints, which covers scratchColumnMI() too,
+**   tableCounts holds pairCapacity + (firstNumStates + secondNumStates) *
+**     (classNumStates + 1) + classNumStates ints.
+**
+** A scratch can only be used by one thread at a time.
+*******************************************************************************/
+typedef struct FSScratch {
+    int *stateMap;
+    uint *pairVector;
+    int *jointCounts;
+    int *tableCounts;
+} FSScratch;
+
+/*******************************************************************************
+** calcJointStatistics() counts the (first,second,class) triples in a single
+** pass over the samples and calculates every field of JointStatistics from
+** the resulting table, replacing separate calls to calcMutualInformation,
+** calcConditionalMutualInformation and calcJointEntropy on the same vectors.
+**
+** If all three columns have bitmap indices and the table is small enough
+** calcJointStatistics() counts it with calcBitmapStatistics(), which ANDs
+** the bitsets together and counts the set bits a word at a time. It numbers
+** the observed pairs by the first row each appears in, the order the dense
+** kernel sees them, so both sum the same table in the same order. If both
+** features are sparse and the class has its state counts, only the stored
+** rows are counted.
+**
+** calcTableStatistics() calculates the JointStatistics of a three way count
+** table, where cell (p,c) is jointCounts[p + numPairStates*c] and pair state
+** p is (pairFirst[p],pairSecond[p]). tableStatistics() is calcTableStatistics()
+** with the block for the marginal counts passed in, zeroed, which is
+** tableCountsLength() ints long.
+**
+** calcTableMI() calculates I(A;B) from a two way count table, where cell
+** (a,b) is jointCounts[a + firstNumStates*b]. The table must be followed by
+** firstNumStates + secondNumStates zeroed ints, which it fills with the
+** marginal counts.
+**
+** calcColumnMI() calculates I(A;B) between two columns, and
+** calcColumnEntropy() calculates H(A). Both count only the stored entries of
+** a sparse column when the other column is sparse or has its state counts.
+**
+** vectorLength is the number of stored rows. When the columns have row
+** counts each row adds its count to the tables rather than one.
+**
+** scratchJointStatistics() and scratchColumnMI() count dense columns in the
+** buffers of scratch rather than allocating their own, and behave as
+** calcJointStatistics() and calcColumnMI() if scratch is NULL. The sparse
+** kernel still allocates, the bitmap kernel counts on the stack.
+*******************************************************************************/
+JointStatistics calcJointStatistics(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn, int vectorLength);
+JointStatistics scratchJointStatistics(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn, int vectorLength, FSScratch *scratch);
+JointStatistics calcTableStatistics(int *jointCounts, int numPairStates, uint *pairFirst, uint *pairSecond, int firstNumStates, int secondNumStates, int classNumStates, int vectorLength);
+JointStatistics tableStatistics(int *jointCounts, int numPairStates, uint *pairFirst, uint *pairSecond, int firstNumStates, int secondNumStates, int classNumStates, int vectorLength, int *pairCounts);
+size_t tableCountsLength(int numPairStates, int firstNumStates, int secondNumStates, int classNumStates);
+int useBitmapStatistics(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn);
+JointStatistics calcBitmapStatistics(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn, int vectorLength);
+double calcTableMI(int *jointCounts, int firstNumStates, int secondNumStates, double totalLength);
+double calcColumnMI(FSColumn *firstColumn, FSColumn *secondColumn, int vectorLength);
+double scratchColumnMI(FSColumn *firstColumn, FSColumn *secondColumn, int vectorLength, FSScratch *scratch);
+double calcColumnEntropy(FSColumn *column, int vectorLength);
+
+/*******************************************************************************
+** FSPairCache holds the terms between each selected feature m and every
+** feature, for a batch of criteria. Only the JointStatistics fields which
+** one of the criteria reads are kept, each in a block of noOfFeatures
+** doubles, so rows[m] holds noOfFields * noOfFeatures doubles once m has
+** been selected and is NULL before. mRMR_D and CMIM need one field, JMI
+** one, DISR two, ICAP and BetaGamma the same two, and MIM none. mRMR_D
+** reads the two column MI from calcColumnMI() as mRMR_D() does, which is
+** kept apart from the MI of the joint table, and jointFields counts the
+** fields which need the joint table.
+**
+** createPairCache() works out the fields which criteria need, and
+** freePairCache() frees the rows. storePairStatistics() copies the cached
+** fields of stats into entry j of a row, and PAIR_TERM reads one back.
+**
+** FSPairRowFunction returns the row of feature m, taking it from the cache
+** if it is there, and otherwise calculating it from source and storing it
+** in cache->rows[m].
+**
+** batchSearch() runs the forward search for one of the pairwise criteria in
+** FSBatch.h from the class MI and the rows returned by pairRow, asking only
+** for the rows of the selected features. The cache must have been created
+** with the criterion. The scores follow the individual algorithm files term
+** for term, and start from the same initial best score so ties resolve the
+** same way.
+*******************************************************************************/
+/*******************************************************************************
+** The forward searches score their candidates the same way, so the column
+** algorithms' rankings and scores are reproduced exactly by the search
+** engine, the batch and online selectors and the shards.
+**
+** startingCandidate() sets the score and index each round's search starts
+** from, which decides the ties BETTER_CANDIDATE can't: CondMI's index is -1
+** so it selects nothing once no candidate adds any information, and a
+** candidate only beats JMI and DISR's 0.0 or MIM and CMIM's -1.0 if it is
+** strictly higher or has a lower index.
+**
+** startingRunningScore() returns a candidate's running score before any
+** terms are added, which is its class MI for CMIM and ICAP and 0 otherwise.
+**
+** criterionTerm() returns the term a selected feature m adds to candidate j
+** from the JointStatistics of (m,j,class). mRMR_D's term is I(X_m;X_j) from
+** calcColumnMI(), which doesn't need the joint table, so its callers pass
+** that to scoreCandidate() instead, and MIM has no term.
+**
+** scoreCandidate() adds term to runningScore as criterion does, and returns
+** the candidate's score in round, the number of features already selected.
+*******************************************************************************/
+void startingCandidate(int criterion, double *score, int *index);
+double startingRunningScore(int criterion, double classMI);
+double criterionTerm(FSCriterion *criterion, JointStatistics *stats);
+double scoreCandidate(FSCriterion *criterion, double term, double classMI, uint round, double *runningScore);
+
+#define FS_PAIR_MI 0
+#define FS_PAIR_CMI 1
+#define FS_PAIR_JOINT_MI 2
+#define FS_PAIR_CLASS_CMI 3
+#define FS_PAIR_JOINT_ENTROPY 4
+#define FS_PAIR_COLUMN_MI 5
+#define FS_PAIR_FIELDS 6
+
+typedef struct FSPairCache {
+    uint noOfFeatures;
+    int noOfFields;
+    int jointFields;
+    int fieldOffsets[FS_PAIR_FIELDS];
+    double **rows;
+} FSPairCache;
+
+#define PAIR_TERM(cache,row,field,j) ((row)[(size_t) (cache)->fieldOffsets[field] * (cache)->noOfFeatures + (j)])
+
+typedef double* (*FSPairRowFunction)(void *source, FSPairCache *cache, uint m);
+
+void createPairCache(uint noOfFeatures, uint noOfCriteria, FSCriterion *criteria, FSPairCache *cache);
+void storePairStatistics(FSPairCache *cache, double *row, uint j, JointStatistics *stats);
+void freePairCache(FSPairCache *cache);
+void batchSearch(uint k, uint noOfFeatures, double *classMI, FSPairCache *cache, FSPairRowFunction pairRow, void *source, FSCriterion *criterion, uint *outputFeatures, double *featureScores);
+
+/*******************************************************************************
+** checkedSearch() selects k features of set with the rounds of FEASTSearch,
+** allocating everything the search and its numThreads threads count in as
+** one block before the first round. Returns FS_OK, or FS_ERROR_MEMORY without
+** selecting anything if that block can't be allocated. The outputs are
+** filled as checkedFeatureSelection() fills them.
+*******************************************************************************/
+int checkedSearch(uint k, FSColumnSet *set, FSCriterion *criterion, uint *outputFeatures, double *featureScores, int numThreads);
+
+/*******************************************************************************
+** The column variants of the algorithms in FSAlgorithms.h, which the uint and
+** disc* entry points call once they have built an FSColumnSet.
+*******************************************************************************/
+uint* columnMIM(uint k, FSColumnSet *set, uint *outputFeatures, double *featureScores, FSOptions *options);
+uint* columnmRMR_D(uint k, FSColumnSet *set, uint *outputFeatures, double *featureScores, FSOptions *options);
+uint* columnCMIM(uint k, FSColumnSet *set, uint *outputFeatures, double *featureScores, FSOptions *options);
+uint* columnJMI(uint k, FSColumnSet *set, uint *outputFeatures, double *featureScores, FSOptions *options);
+uint* columnDISR(uint k, FSColumnSet *set, uint *outputFeatures, double *featureScores, FSOptions *options);
+uint* columnICAP(uint k, FSColumnSet *set, uint *outputFeatures, double *featureScores, FSOptions *options);
+int* columnCondMI(uint k, FSColumnSet *set, int *outputFeatures, double *featureScores, FSOptions *options);
+uint* columnBetaGamma(uint k, FSColumnSet *set, uint *outputFeatures, double *featureScores, double betaParam, double gammaParam, FSOptions *options);
+
+#endif
@@ -0,0 +1,524 @@
+/*******************************************************************************
+** FSJointStatistics.c
+** Implements a fused kernel which builds the three way contingency table of a
+** selected feature, a candidate feature and the class in one pass over the
+** samples, and derives the MI, conditional MI and joint entropy terms used by
+** the forward searches from it. Also holds the pairwise MI kernel. Both read
+** the columns at their stored width. Pairs of sparse columns are counted from
+** their nonzero samples, and the zero cells are found by subtraction.
+** Collapsed duplicate rows add their counts to the tables.
+**
+** Author: Adam Pocock
+** Created: 17/10/2026
+**
+** Part of the FEAture Selection Toolbox (FEAST), please reference
+** "Conditional Likelihood Maximisation: A Unifying Framework for Information
+** Theoretic Feature Selection"
+** G. Brown, A. Pocock, M.-J. Zhao, M. Lujan
+** Journal of Machine Learning Research (JMLR), 2012
+**
+** Please check www.github.com/Craigacp/FEAST for updates.
+** 
+** Copyright (c) 2010-2017, A. Pocock, G. Brown, The University of Manchester
+** All rights reserved.
+** 
+** Redistribution and use in source and binary forms, with or without modification,
+** are permitted provided that the following conditions are met:
+** 
+**   - Redistributions of source code must retain the above copyright notice, this 
+**     list of conditions and the following disclaimer.
+**   - Redistributions in binary form must reproduce the above copyright notice, 
+**     this list of conditions and the following disclaimer in the documentation 
+**     and/or other materials provided with the distribution.
+**   - Neither the name of The University of Manchester nor the names of its 
+**     contributors may be used to endorse or promote products derived from this 
+**     software without specific prior written permission.
+** 
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+** ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+** ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+** (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+** LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+** ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+** SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+*******************************************************************************/
+
+
+#include "FEAST/FSToolbox.h"
+#include "FSInternal.h"
+
+/* for memset */
+#include <string.h>
+
+size_t tableCountsLength(int numPairStates, int firstNumStates, int secondNumStates, int classNumStates) {
+    return numPairStates + (size_t) (firstNumStates + secondNumStates) * (classNumStates + 1) + classNumStates;
+}/*tableCountsLength(int,int,int,int)*/
+
+JointStatistics tableStatistics(int *jointCounts, int numPairStates, uint *pairFirst, uint *pairSecond, int firstNumStates, int secondNumStates, int classNumStates, int vectorLength, int *pairCounts) {
+    JointStatistics stats;
+
+    /*all the marginal counts live in one block*/
+    int *firstClassCounts = pairCounts + numPairStates;
+    int *secondClassCounts = firstClassCounts + firstNumStates * classNumStates;
+    int *firstCounts = secondClassCounts + secondNumStates * classNumStates;
+    int *secondCounts = firstCounts + firstNumStates;
+    int *classCounts = secondCounts + secondNumStates;
+    int count, pairState, c;
+
+    double jointCount, pairCount, firstCount, firstClassCount, secondClassCount;
+    double classCount;
+    double totalLength = vectorLength;
+
+    /*the marginal tables are summed out of the three way table*/
+    for (c = 0; c < classNumStates; c++) {
+        for (pairState = 0; pairState < numPairStates; pairState++) {
+            count = jointCounts[pairState + numPairStates * c];
+            pairCounts[pairState] += count;
+            firstClassCounts[pairFirst[pairState] + firstNumStates * c] += count;
+            secondClassCounts[pairSecond[pairState] + secondNumStates * c] += count;
+            classCounts[c] += count;
+        }
+    }
+
+    for (pairState = 0; pairState < numPairStates; pairState++) {
+        firstCounts[pairFirst[pairState]] += pairCounts[pairState];
+        secondCounts[pairSecond[pairState]] += pairCounts[pairState];
+    }
+
+    /*each term is a ratio of counts, so the terms of exactly independent
+     **states are log(1) = 0 and sum to exactly zero*/
+    stats.mi = 0.0;
+    stats.cmi = 0.0;
+    stats.jointMI = 0.0;
+    stats.classCMI = 0.0;
+    stats.jointEntropy = 0.0;
+
+    for (pairState = 0; pairState < numPairStates; pairState++) {
+        pairCount = pairCounts[pairState];
+        if (pairCount > 0) {
+            stats.mi += pairCount * log((pairCount * totalLength) / ((double) firstCounts[pairFirst[pairState]] * secondCounts[pairSecond[pairState]]));
+        }
+    }
+
+    for (c = 0; c < classNumStates; c++) {
+        classCount = classCounts[c];
+        for (pairState = 0; pairState < numPairStates; pairState++) {
+            jointCount = jointCounts[pairState + numPairStates * c];
+            if (jointCount > 0) {
+                pairCount = pairCounts[pairState];
+                firstCount = firstCounts[pairFirst[pairState]];
+                firstClassCount = firstClassCounts[pairFirst[pairState] + firstNumStates * c];
+                secondClassCount = secondClassCounts[pairSecond[pairState] + secondNumStates * c];
+
+                stats.cmi += jointCount * log((jointCount * classCount) / (firstClassCount * secondClassCount));
+                stats.jointMI += jointCount * log((jointCount * totalLength) / (pairCount * classCount));
+                stats.classCMI += jointCount * log((jointCount * firstCount) / (pairCount * firstClassCount));
+                stats.jointEntropy -= jointCount * log(jointCount / totalLength);
+            }
+        }
+    }
+
+    stats.mi /= totalLength * log(LOG_BASE);
+    stats.cmi /= totalLength * log(LOG_BASE);
+    stats.jointMI /= totalLength * log(LOG_BASE);
+    stats.classCMI /= totalLength * log(LOG_BASE);
+    stats.jointEntropy /= totalLength * log(LOG_BASE);
+
+    return stats;
+}/*tableStatistics(int[],int,uint[],uint[],int,int,int,int,int[])*/
+
+JointStatistics calcTableStatistics(int *jointCounts, int numPairStates, uint *pairFirst, uint *pairSecond, int firstNumStates, int secondNumStates, int classNumStates, int vectorLength) {
+    JointStatistics stats;
+    int *pairCounts = (int *) checkedCalloc(tableCountsLength(numPairStates,firstNumStates,secondNumStates,classNumStates),sizeof(int));
+
+    stats = tableStatistics(jointCounts,numPairStates,pairFirst,pairSecond,firstNumStates,secondNumStates,classNumStates,vectorLength,pairCounts);
+
+    FREE_FUNC(pairCounts);
+    pairCounts = NULL;
+
+    return stats;
+}/*calcTableStatistics(int[],int,uint[],uint[],int,int,int,int)*/
+
+/*******************************************************************************
+** mergeSparseRows() walks the rows which are stored in either of two sparse
+** columns in increasing order, writing each row and its joint state
+** firstValue + secondValue * firstNumStates. rows and jointStates need space
+** for both columns' entries. Returns the number of rows.
+*******************************************************************************/
+static int mergeSparseRows(FSColumn *firstColumn, FSColumn *secondColumn, uint *rows, int *jointStates) {
+    uint *firstValues = (uint *) firstColumn->data;
+    uint *secondValues = (uint *) secondColumn->data;
+    int firstNumStates = firstColumn->numStates;
+    int p = 0, q = 0, noOfRows = 0;
+
+    while ((p < firstColumn->noOfEntries) || (q < secondColumn->noOfEntries)) {
+        if ((q >= secondColumn->noOfEntries) || ((p < firstColumn->noOfEntries) && (firstColumn->rowIndices[p] < secondColumn->rowIndices[q]))) {
+            rows[noOfRows] = firstColumn->rowIndices[p];
+            jointStates[noOfRows] = firstValues[p];
+            p++;
+        } else if ((p >= firstColumn->noOfEntries) || (secondColumn->rowIndices[q] < firstColumn->rowIndices[p])) {
+            rows[noOfRows] = secondColumn->rowIndices[q];
+            jointStates[noOfRows] = secondValues[q] * firstNumStates;
+            q++;
+        } else {
+            rows[noOfRows] = firstColumn->rowIndices[p];
+            jointStates[noOfRows] = firstValues[p] + secondValues[q] * firstNumStates;
+            p++;
+            q++;
+        }
+        noOfRows++;
+    }
+
+    return noOfRows;
+}/*mergeSparseRows(FSColumn*,FSColumn*,uint[],int[])*/
+
+/*******************************************************************************
+** calcSparseStatistics() is calcJointStatistics() for two sparse columns and
+** a dense class with its state counts. Only the rows stored in either column
+** are visited, and the rows where both are zero are the class counts less
+** those rows. The pair states are numbered in the order the dense kernel
+** sees them, so the table and the statistics are identical.
+*******************************************************************************/
+static JointStatistics calcSparseStatistics(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn, int vectorLength) {
+    JointStatistics stats;
+
+    int firstNumStates = firstColumn->numStates;
+    int secondNumStates = secondColumn->numStates;
+    int classNumStates = classColumn->numStates;
+
+    int capacity = firstColumn->noOfEntries + secondColumn->noOfEntries;
+    uint *rows = (uint *) checkedCalloc(capacity + 1,sizeof(uint));
+    int *jointStates = (int *) checkedCalloc(capacity + 1,sizeof(int));
+    int *stateMap = (int *) checkedCalloc((size_t) firstNumStates * secondNumStates,sizeof(int));
+    int noOfRows = mergeSparseRows(firstColumn, secondColumn, rows, jointStates);
+
+    int pairCapacity = firstNumStates * secondNumStates < noOfRows + 1 ? firstNumStates * secondNumStates : noOfRows + 1;
+    uint *pairFirst = (uint *) checkedCalloc(2*pairCapacity,sizeof(uint));
+    uint *pairSecond = pairFirst + pairCapacity;
+
+    int *jointCounts, *rowClassCounts;
+    int numPairStates = 0;
+    uint nextRow = 0;
+    int i, c;
+
+    for (i = 0; i < noOfRows; i++) {
+        /*the zero pair is first seen at the first row missing from both columns*/
+        if ((stateMap[0] == 0) && (rows[i] > nextRow)) {
+            pairFirst[numPairStates] = 0;
+            pairSecond[numPairStates] = 0;
+            numPairStates++;
+            stateMap[0] = numPairStates;
+        }
+        if (stateMap[jointStates[i]] == 0) {
+            pairFirst[numPairStates] = jointStates[i] % firstNumStates;
+            pairSecond[numPairStates] = jointStates[i] / firstNumStates;
+            numPairStates++;
+            stateMap[jointStates[i]] = numPairStates;
+        }
+        jointStates[i] = stateMap[jointStates[i]] - 1;
+        nextRow = rows[i] + 1;
+    }
+
+    if ((stateMap[0] == 0) && (nextRow < (uint) vectorLength)) {
+        pairFirst[numPairStates] = 0;
+        pairSecond[numPairStates] = 0;
+        numPairStates++;
+        stateMap[0] = numPairStates;
+    }
+
+    jointCounts = (int *) checkedCalloc(numPairStates * classNumStates + classNumStates,sizeof(int));
+    rowClassCounts = jointCounts + numPairStates * classNumStates;
+
+    for (i = 0; i < noOfRows; i++) {
+        c = columnValue(classColumn, rows[i]);
+        jointCounts[jointStates[i] + numPairStates * c]++;
+        rowClassCounts[c]++;
+    }
+
+    if (noOfRows < vectorLength) {
+        for (c = 0; c < classNumStates; c++) {
+            jointCounts[(stateMap[0] - 1) + numPairStates * c] += classColumn->stateCounts[c] - rowClassCounts[c];
+        }
+    }
+
+    stats = calcTableStatistics(jointCounts,numPairStates,pairFirst,pairSecond,firstNumStates,secondNumStates,classNumStates,vectorLength);
+
+    FREE_FUNC(rows);
+    FREE_FUNC(jointStates);
+    FREE_FUNC(stateMap);
+    FREE_FUNC(pairFirst);
+    FREE_FUNC(jointCounts);
+
+    rows = NULL;
+    jointStates = NULL;
+    stateMap = NULL;
+    pairFirst = NULL;
+    jointCounts = NULL;
+
+    return stats;
+}/*calcSparseStatistics(FSColumn*,FSColumn*,FSColumn*,int)*/
+
+JointStatistics calcJointStatistics(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn, int vectorLength) {
+    return scratchJointStatistics(firstColumn,secondColumn,classColumn,vectorLength,NULL);
+}/*calcJointStatistics(FSColumn*,FSColumn*,FSColumn*,int)*/
+
+JointStatistics scratchJointStatistics(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn, int vectorLength, FSScratch *scratch) {
+    JointStatistics stats;
+
+    int firstNumStates = firstColumn->numStates;
+    int secondNumStates = secondColumn->numStates;
+    int classNumStates = classColumn->numStates;
+
+    /*the observed (first,second) pairs are renumbered densely, as in mergeArrays,
+     **so the three way table has at most vectorLength * classNumStates cells*/
+    int pairCapacity;
+    int *stateMap;
+    uint *pairVector, *pairFirst, *pairSecond;
+
+    int *jointCounts;
+    uint *rowCounts = classColumn->rowCounts;
+    int numPairStates = 0;
+    int curIndex, start, length, i;
+    int block[FS_BLOCK_SIZE];
+
+    if ((firstColumn->rowIndices != NULL) && (secondColumn->rowIndices != NULL) && (classColumn->stateCounts != NULL)) {
+        return calcSparseStatistics(firstColumn,secondColumn,classColumn,vectorLength);
+    }
+
+    if (useBitmapStatistics(firstColumn,secondColumn,classColumn)) {
+        return calcBitmapStatistics(firstColumn,secondColumn,classColumn,vectorLength);
+    }
+
+    pairCapacity = firstNumStates * secondNumStates < vectorLength ? firstNumStates * secondNumStates : vectorLength;
+    if (scratch == NULL) {
+        stateMap = (int *) checkedCalloc((size_t) firstNumStates * secondNumStates,sizeof(int));
+        pairVector = (uint *) checkedCalloc(vectorLength + 2*pairCapacity,sizeof(uint));
+    } else {
+        /*the scratch state map is kept zeroed between calls*/
+        stateMap = scratch->stateMap;
+        pairVector = scratch->pairVector;
+    }
+    pairFirst = pairVector + vectorLength;
+    pairSecond = pairFirst + pairCapacity;
+
+    for (start = 0; start < vectorLength; start += FS_BLOCK_SIZE) {
+        length = vectorLength - start < FS_BLOCK_SIZE ? vectorLength - start : FS_BLOCK_SIZE;
+        loadColumnBlock(firstColumn,start,length,block);
+        addColumnBlock(secondColumn,start,length,firstNumStates,block);
+        for (i = 0; i < length; i++) {
+            curIndex = block[i];
+            if (stateMap[curIndex] == 0) {
+                pairFirst[numPairStates] = curIndex % firstNumStates;
+                pairSecond[numPairStates] = curIndex / firstNumStates;
+                numPairStates++;
+                stateMap[curIndex] = numPairStates;
+            }
+            pairVector[start + i] = stateMap[curIndex] - 1;
+        }
+    }
+
+    if (scratch == NULL) {
+        jointCounts = (int *) checkedCalloc(numPairStates * classNumStates,sizeof(int));
+    } else {
+        jointCounts = scratch->jointCounts;
+        memset(jointCounts, 0, sizeof(int) * numPairStates * classNumStates);
+    }
+
+    for (start = 0; start < vectorLength; start += FS_BLOCK_SIZE) {
+        length = vectorLength - start < FS_BLOCK_SIZE ? vectorLength - start : FS_BLOCK_SIZE;
+        loadColumnBlock(classColumn,start,length,block);
+        if (rowCounts == NULL) {
+            for (i = 0; i < length; i++) {
+                jointCounts[pairVector[start + i] + numPairStates * block[i]]++;
+            }
+        } else {
+            for (i = 0; i < length; i++) {
+                jointCounts[pairVector[start + i] + numPairStates * block[i]] += rowCounts[start + i];
+            }
+        }
+    }
+
+    if (scratch == NULL) {
+        stats = calcTableStatistics(jointCounts,numPairStates,pairFirst,pairSecond,firstNumStates,secondNumStates,classNumStates,countedLength(classColumn,vectorLength));
+
+        FREE_FUNC(stateMap);
+        FREE_FUNC(pairVector);
+        FREE_FUNC(jointCounts);
+    } else {
+        memset(scratch->tableCounts, 0, sizeof(int) * tableCountsLength(numPairStates,firstNumStates,secondNumStates,classNumStates));
+        stats = tableStatistics(jointCounts,numPairStates,pairFirst,pairSecond,firstNumStates,secondNumStates,classNumStates,countedLength(classColumn,vectorLength),scratch->tableCounts);
+
+        /*only the observed cells of the state map were set*/
+        for (i = 0; i < numPairStates; i++) {
+            stateMap[pairFirst[i] + firstNumStates * pairSecond[i]] = 0;
+        }
+    }
+
+    stateMap = NULL;
+    pairVector = NULL;
+    jointCounts = NULL;
+
+    return stats;
+}/*scratchJointStatistics(FSColumn*,FSColumn*,FSColumn*,int,FSScratch*)*/
+
+double calcTableMI(int *jointCounts, int firstNumStates, int secondNumStates, double totalLength) {
+    int jointNumStates = firstNumStates * secondNumStates;
+    int *firstCounts = jointCounts + jointNumStates;
+    int *secondCounts = firstCounts + firstNumStates;
+    int i;
+
+    double mi = 0.0;
+    double jointCount;
+
+    for (i = 0; i < jointNumStates; i++) {
+        firstCounts[i % firstNumStates] += jointCounts[i];
+        secondCounts[i / firstNumStates] += jointCounts[i];
+    }
+
+    for (i = 0; i < jointNumStates; i++) {
+        jointCount = jointCounts[i];
+        if (jointCount > 0) {
+            mi += jointCount * log((jointCount * totalLength) / ((double) firstCounts[i % firstNumStates] * secondCounts[i / firstNumStates]));
+        }
+    }
+
+    mi /= totalLength * log(LOG_BASE);
+
+    return mi;
+}/*calcTableMI(int[],int,int,double)*/
+
+double calcColumnMI(FSColumn *firstColumn, FSColumn *secondColumn, int vectorLength) {
+    return scratchColumnMI(firstColumn,secondColumn,vectorLength,NULL);
+}/*calcColumnMI(FSColumn*,FSColumn*,int)*/
+
+double scratchColumnMI(FSColumn *firstColumn, FSColumn *secondColumn, int vectorLength, FSScratch *scratch) {
+    int firstNumStates = firstColumn->numStates;
+    int secondNumStates = secondColumn->numStates;
+    int jointNumStates = firstNumStates * secondNumStates;
+
+    int *jointCounts = scratch == NULL ? (int *) checkedCalloc(jointNumStates + firstNumStates + secondNumStates,sizeof(int)) : (int *) memset(scratch->jointCounts, 0, sizeof(int) * (jointNumStates + firstNumStates + secondNumStates));
+    int *firstCounts = jointCounts + jointNumStates;
+    int *secondCounts = firstCounts + firstNumStates;
+    int block[FS_BLOCK_SIZE];
+    int start, length, i, c;
+    uint *rows, *entryValues;
+    int *jointStates;
+    int noOfRows;
+
+    double mi;
+    double totalLength = vectorLength;
+
+    if ((firstColumn->rowIndices != NULL) && (secondColumn->rowIndices != NULL)) {
+        /*the rows missing from both columns are the (0,0) cell*/
+        rows = (uint *) checkedCalloc(firstColumn->noOfEntries + secondColumn->noOfEntries + 1,sizeof(uint));
+        jointStates = (int *) checkedCalloc(firstColumn->noOfEntries + secondColumn->noOfEntries + 1,sizeof(int));
+        noOfRows = mergeSparseRows(firstColumn, secondColumn, rows, jointStates);
+        for (i = 0; i < noOfRows; i++) {
+            jointCounts[jointStates[i]]++;
+        }
+        jointCounts[0] += vectorLength - noOfRows;
+        FREE_FUNC(rows);
+        FREE_FUNC(jointStates);
+        rows = NULL;
+        jointStates = NULL;
+    } else if ((firstColumn->rowIndices != NULL) && (secondColumn->stateCounts != NULL)) {
+        /*the zeros of the first column are the second column's counts less its entries*/
+        entryValues = (uint *) firstColumn->data;
+        for (i = 0; i < firstColumn->noOfEntries; i++) {
+            c = columnValue(secondColumn, firstColumn->rowIndices[i]);
+            jointCounts[entryValues[i] + firstNumStates * c]++;
+            secondCounts[c]++;
+        }
+        for (c = 0; c < secondNumStates; c++) {
+            jointCounts[firstNumStates * c] += secondColumn->stateCounts[c] - secondCounts[c];
+            secondCounts[c] = 0;
+        }
+    } else if ((secondColumn->rowIndices != NULL) && (firstColumn->stateCounts != NULL)) {
+        entryValues = (uint *) secondColumn->data;
+        for (i = 0; i < secondColumn->noOfEntries; i++) {
+            c = columnValue(firstColumn, secondColumn->rowIndices[i]);
+            jointCounts[c + firstNumStates * entryValues[i]]++;
+            firstCounts[c]++;
+        }
+        for (c = 0; c < firstNumStates; c++) {
+            jointCounts[c] += firstColumn->stateCounts[c] - firstCounts[c];
+            firstCounts[c] = 0;
+        }
+    } else {
+        for (start = 0; start < vectorLength; start += FS_BLOCK_SIZE) {
+            length = vectorLength - start < FS_BLOCK_SIZE ? vectorLength - start : FS_BLOCK_SIZE;
+            loadColumnBlock(firstColumn,start,length,block);
+            addColumnBlock(secondColumn,start,length,firstNumStates,block);
+            if (firstColumn->rowCounts == NULL) {
+                for (i = 0; i < length; i++) {
+                    jointCounts[block[i]]++;
+                }
+            } else {
+                for (i = 0; i < length; i++) {
+                    jointCounts[block[i]] += firstColumn->rowCounts[start + i];
+                }
+            }
+        }
+        totalLength = countedLength(firstColumn,vectorLength);
+    }
+
+    mi = calcTableMI(jointCounts,firstNumStates,secondNumStates,totalLength);
+
+    if (scratch == NULL) {
+        FREE_FUNC(jointCounts);
+    }
+    jointCounts = NULL;
+
+    return mi;
+}/*scratchColumnMI(FSColumn*,FSColumn*,int,FSScratch*)*/
+
+double calcColumnEntropy(FSColumn *column, int vectorLength) {
+    int *counts = (int *) checkedCalloc(column->numStates,sizeof(int));
+    int block[FS_BLOCK_SIZE];
+    int start, length, i;
+
+    double entropy = 0.0;
+    double count;
+    double totalLength = vectorLength;
+
+    if (column->rowIndices != NULL) {
+        /*every sample which isn't stored is zero*/
+        for (i = 0; i < column->noOfEntries; i++) {
+            counts[((uint *) column->data)[i]]++;
+        }
+        counts[0] += vectorLength - column->noOfEntries;
+    } else {
+        for (start = 0; start < vectorLength; start += FS_BLOCK_SIZE) {
+            length = vectorLength - start < FS_BLOCK_SIZE ? vectorLength - start : FS_BLOCK_SIZE;
+            loadColumnBlock(column,start,length,block);
+            if (column->rowCounts == NULL) {
+                for (i = 0; i < length; i++) {
+                    counts[block[i]]++;
+                }
+            } else {
+                for (i = 0; i < length; i++) {
+                    counts[block[i]] += column->rowCounts[start + i];
+                }
+            }
+        }
+        totalLength = countedLength(column,vectorLength);
+    }
+
+    for (i = 0; i < column->numStates; i++) {
+        count = counts[i];
+        if (count > 0) {
+            entropy -= count * log(count / totalLength);
+        }
+    }
+
+    entropy /= totalLength * log(LOG_BASE);
+
+    FREE_FUNC(counts);
+    counts = NULL;
+
+    return entropy;
+}/*calcColumnEntropy(FSColumn*,int)*/
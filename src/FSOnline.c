@@ -0,0 +1,338 @@
+/*******************************************************************************
+** FSOnline.c
+** Implements FEASTSelector, which keeps the count tables behind the pairwise
+** criteria up to date as samples arrive and ranks the features from them.
+**
+** Author: Adam Pocock
+** Created: 17/10/2026
+**
+** Part of the FEAture Selection Toolbox (FEAST), please reference
+** "Conditional Likelihood Maximisation: A Unifying Framework for Information
+** Theoretic Feature Selection"
+** G. Brown, A. Pocock, M.-J. Zhao, M. Lujan
+** Journal of Machine Learning Research (JMLR), 2012
+**
+** Please check www.github.com/Craigacp/FEAST for updates.
+** 
+** Copyright (c) 2010-2017, A. Pocock, G. Brown, The University of Manchester
+** All rights reserved.
+** 
+** Redistribution and use in source and binary forms, with or without modification,
+** are permitted provided that the following conditions are met:
+** 
+**   - Redistributions of source code must retain the above copyright notice, this 
+**     list of conditions and the following disclaimer.
+**   - Redistributions in binary form must reproduce the above copyright notice, 
+**     this list of conditions and the following disclaimer in the documentation 
+**     and/or other materials provided with the distribution.
+**   - Neither the name of The University of Manchester nor the names of its 
+**     contributors may be used to endorse or promote products derived from this 
+**     software without specific prior written permission.
+** 
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+** ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+** ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+** (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+** LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+** ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+** SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+*******************************************************************************/
+
+
+#include "FEAST/FSOnline.h"
+#include "FEAST/FSToolbox.h"
+#include "FSInternal.h"
+
+/*******************************************************************************
+** counts holds every table in one block. The (feature,class) table of
+** feature f starts at classOffsets[f] with cell (x,c) at x + numStates[f]*c.
+** The tables of the pairs (f,g) with g > f follow each other from
+** pairOffsets[f] in order of g, so with stateSums[g] the sum of numStates
+** below g the table of f < g starts at pairOffset(selector,f,g), with cell
+** (a,b,c) at a + numStates[f]*b + numStates[f]*numStates[g]*c.
+**
+** window holds the counted samples as rows of noOfFeatures + 1 values with
+** the class last, in a ring starting at windowStart. It is NULL when every
+** sample is kept.
+*******************************************************************************/
+struct FEASTSelector {
+    uint noOfFeatures;
+    uint *numStates;
+    size_t *stateSums;
+    uint classNumStates;
+    uint noOfSamples;
+    uint windowSize;
+    uint windowStart;
+    uint *window;
+    int *counts;
+    size_t *classOffsets;
+    size_t *pairOffsets;
+};
+
+/*******************************************************************************
+** pairOffset() returns the start of the table of features f < g.
+*******************************************************************************/
+static size_t pairOffset(FEASTSelector *selector, uint f, uint g) {
+    return selector->pairOffsets[f] + (size_t) selector->numStates[f] * selector->classNumStates * (selector->stateSums[g] - selector->stateSums[f + 1]);
+}/*pairOffset(FEASTSelector*,uint,uint)*/
+
+/*******************************************************************************
+** countSample() adds delta to every cell a sample falls in, where sample
+** holds the feature values followed by the class.
+*******************************************************************************/
+static void countSample(FEASTSelector *selector, uint *sample, int delta) {
+    uint noOfFeatures = selector->noOfFeatures;
+    uint *numStates = selector->numStates;
+    uint classState = sample[noOfFeatures];
+    size_t firstOffset;
+    uint f, g;
+
+    for (f = 0; f < noOfFeatures; f++) {
+        selector->counts[selector->classOffsets[f] + sample[f] + (size_t) numStates[f] * classState] += delta;
+        for (g = f + 1; g < noOfFeatures; g++) {
+            firstOffset = sample[f] + (size_t) numStates[f] * sample[g];
+            selector->counts[pairOffset(selector,f,g) + firstOffset + (size_t) numStates[f] * numStates[g] * classState] += delta;
+        }
+    }
+}/*countSample(FEASTSelector*,uint[],int)*/
+
+/*******************************************************************************
+** selectorPairRow() is the FSPairRowFunction of a selector, building the
+** three way table of (m,j,class) for each feature j from the pair counts.
+** The pairs are numbered in index order, skipping the empty ones.
+*******************************************************************************/
+static double* selectorPairRow(void *source, FSPairCache *cache, uint m) {
+    FEASTSelector *selector = (FEASTSelector *) source;
+    uint noOfFeatures = selector->noOfFeatures;
+    uint *numStates = selector->numStates;
+    int classNumStates = selector->classNumStates;
+    int firstNumStates = numStates[m];
+    int secondNumStates, maxNumStates = 1;
+    JointStatistics stats;
+    double *row;
+    int *table, *jointCounts;
+    uint *pairFirst, *pairSecond;
+    size_t firstStride, secondStride, classStride, cell;
+    int numPairStates, pairCount, a, b, c;
+    uint j;
+
+    if (cache->rows[m] != NULL) {
+        return cache->rows[m];
+    }
+
+    for (j = 0; j < noOfFeatures; j++) {
+        maxNumStates = (int) numStates[j] > maxNumStates ? (int) numStates[j] : maxNumStates;
+    }
+
+    row = (double *) checkedCalloc((size_t) cache->noOfFields * noOfFeatures,sizeof(double));
+    jointCounts = (int *) checkedCalloc((size_t) firstNumStates * maxNumStates * classNumStates,sizeof(int));
+    pairFirst = (uint *) checkedCalloc(2 * (size_t) firstNumStates * maxNumStates,sizeof(uint));
+    pairSecond = pairFirst + (size_t) firstNumStates * maxNumStates;
+
+    for (j = 0; j < noOfFeatures; j++) {
+        if (j == m) {
+            continue;
+        }
+        secondNumStates = numStates[j];
+
+        /*the table is stored with the lower index first, so m may be its second feature*/
+        if (m < j) {
+            table = selector->counts + pairOffset(selector,m,j);
+            firstStride = 1;
+            secondStride = firstNumStates;
+        } else {
+            table = selector->counts + pairOffset(selector,j,m);
+            firstStride = secondNumStates;
+            secondStride = 1;
+        }
+        classStride = (size_t) firstNumStates * secondNumStates;
+
+        numPairStates = 0;
+        for (b = 0; b < secondNumStates; b++) {
+            for (a = 0; a < firstNumStates; a++) {
+                cell = a * firstStride + b * secondStride;
+                pairCount = 0;
+                for (c = 0; c < classNumStates; c++) {
+                    pairCount += table[cell + c * classStride];
+                }
+                if (pairCount > 0) {
+                    pairFirst[numPairStates] = a;
+                    pairSecond[numPairStates] = b;
+                    numPairStates++;
+                }
+            }
+        }
+
+        for (c = 0; c < classNumStates; c++) {
+            for (a = 0; a < numPairStates; a++) {
+                cell = pairFirst[a] * firstStride + pairSecond[a] * secondStride;
+                jointCounts[a + numPairStates * c] = table[cell + c * classStride];
+            }
+        }
+
+        /*JointStatistics calcTableStatistics(int *jointCounts, int numPairStates, uint *pairFirst, uint *pairSecond, int firstNumStates, int secondNumStates, int classNumStates, int vectorLength);*/
+        stats = calcTableStatistics(jointCounts,numPairStates,pairFirst,pairSecond,firstNumStates,secondNumStates,classNumStates,selector->noOfSamples);
+        storePairStatistics(cache, row, j, &stats);
+        /*the two column MI is summed from the same table*/
+        if (cache->fieldOffsets[FS_PAIR_COLUMN_MI] != -1) {
+            PAIR_TERM(cache,row,FS_PAIR_COLUMN_MI,j) = stats.mi;
+        }
+    }
+
+    FREE_FUNC(jointCounts);
+    FREE_FUNC(pairFirst);
+    jointCounts = NULL;
+    pairFirst = NULL;
+
+    cache->rows[m] = row;
+
+    return row;
+}/*selectorPairRow(void*,FSPairCache*,uint)*/
+
+FEASTSelector* createFEASTSelector(uint noOfFeatures, uint *numStates, uint classNumStates, uint windowSize) {
+    FEASTSelector *selector = (FEASTSelector *) checkedCalloc(1,sizeof(FEASTSelector));
+    size_t totalCells = 0;
+    uint f, g;
+
+    selector->noOfFeatures = noOfFeatures;
+    selector->numStates = (uint *) checkedCalloc(noOfFeatures + 1,sizeof(uint));
+    selector->classNumStates = classNumStates < 1 ? 1 : classNumStates;
+    selector->noOfSamples = 0;
+    selector->windowSize = windowSize;
+    selector->windowStart = 0;
+    selector->window = windowSize > 0 ? (uint *) checkedCalloc((size_t) windowSize * (noOfFeatures + 1),sizeof(uint)) : NULL;
+    selector->classOffsets = (size_t *) checkedCalloc(noOfFeatures + 1,sizeof(size_t));
+    selector->pairOffsets = (size_t *) checkedCalloc(noOfFeatures + 1,sizeof(size_t));
+    selector->stateSums = (size_t *) checkedCalloc(noOfFeatures + 1,sizeof(size_t));
+
+    for (f = 0; f < noOfFeatures; f++) {
+        selector->numStates[f] = numStates[f] < 1 ? 1 : numStates[f];
+        selector->stateSums[f + 1] = selector->stateSums[f] + selector->numStates[f];
+    }
+
+    for (f = 0; f < noOfFeatures; f++) {
+        selector->classOffsets[f] = totalCells;
+        totalCells += (size_t) selector->numStates[f] * selector->classNumStates;
+    }
+
+    for (f = 0; f < noOfFeatures; f++) {
+        selector->pairOffsets[f] = totalCells;
+        for (g = f + 1; g < noOfFeatures; g++) {
+            totalCells += (size_t) selector->numStates[f] * selector->numStates[g] * selector->classNumStates;
+        }
+    }
+
+    selector->counts = (int *) checkedCalloc(totalCells + 1,sizeof(int));
+
+    return selector;
+}/*createFEASTSelector(uint,uint[],uint,uint)*/
+
+int addFEASTSamples(FEASTSelector *selector, uint noOfSamples, uint **featureMatrix, uint *classColumn) {
+    uint noOfFeatures = selector->noOfFeatures;
+    uint *sample;
+    uint i, f;
+
+    /*the tables count in ints, so the samples kept can't pass INT_MAX*/
+    if ((noOfSamples > (uint) INT_MAX - selector->noOfSamples)
+        && ((selector->window == NULL) || (selector->windowSize > (uint) INT_MAX))) {
+        return -1;
+    }
+
+    /*check every value first, so a bad batch leaves the tables untouched*/
+    for (i = 0; i < noOfSamples; i++) {
+        if (classColumn[i] >= selector->classNumStates) {
+            return -1;
+        }
+        for (f = 0; f < noOfFeatures; f++) {
+            if (featureMatrix[f][i] >= selector->numStates[f]) {
+                return -1;
+            }
+        }
+    }
+
+    sample = (uint *) checkedCalloc(noOfFeatures + 1,sizeof(uint));
+
+    for (i = 0; i < noOfSamples; i++) {
+        for (f = 0; f < noOfFeatures; f++) {
+            sample[f] = featureMatrix[f][i];
+        }
+        sample[noOfFeatures] = classColumn[i];
+
+        if (selector->window == NULL) {
+            selector->noOfSamples++;
+        } else if (selector->noOfSamples < selector->windowSize) {
+            memcpy(selector->window + (size_t) ((selector->windowStart + selector->noOfSamples) % selector->windowSize) * (noOfFeatures + 1), sample, sizeof(uint) * (noOfFeatures + 1));
+            selector->noOfSamples++;
+        } else {
+            /*the oldest sample leaves the window, and its slot takes the new one*/
+            countSample(selector, selector->window + (size_t) selector->windowStart * (noOfFeatures + 1), -1);
+            memcpy(selector->window + (size_t) selector->windowStart * (noOfFeatures + 1), sample, sizeof(uint) * (noOfFeatures + 1));
+            selector->windowStart = (selector->windowStart + 1) % selector->windowSize;
+        }
+
+        countSample(selector, sample, 1);
+    }
+
+    FREE_FUNC(sample);
+    sample = NULL;
+
+    return 0;
+}/*addFEASTSamples(FEASTSelector*,uint,uint[][],uint[])*/
+
+uint selectorNoOfSamples(FEASTSelector *selector) {
+    return selector->noOfSamples;
+}/*selectorNoOfSamples(FEASTSelector*)*/
+
+uint* selectorSearch(uint k, FEASTSelector *selector, FSCriterion *criterion, uint *outputFeatures, double *featureScores) {
+    uint noOfFeatures = selector->noOfFeatures;
+    int classNumStates = selector->classNumStates;
+    double *classMI;
+    int *classTable;
+    FSPairCache cache;
+    size_t tableSize;
+    uint f;
+
+    if ((criterion->criterion == FS_CONDMI) || (selector->noOfSamples == 0)) {
+        return NULL;
+    }
+
+    classMI = (double *) checkedCalloc(noOfFeatures + 1,sizeof(double));
+    createPairCache(noOfFeatures, 1, criterion, &cache);
+
+    for (f = 0; f < noOfFeatures; f++) {
+        /*double calcTableMI(int *jointCounts, int firstNumStates, int secondNumStates, double totalLength);*/
+        tableSize = (size_t) selector->numStates[f] * classNumStates;
+        classTable = (int *) checkedCalloc(tableSize + selector->numStates[f] + classNumStates,sizeof(int));
+        memcpy(classTable, selector->counts + selector->classOffsets[f], sizeof(int) * tableSize);
+        classMI[f] = calcTableMI(classTable, selector->numStates[f], classNumStates, selector->noOfSamples);
+        FREE_FUNC(classTable);
+        classTable = NULL;
+    }
+
+    batchSearch(k, noOfFeatures, classMI, &cache, selectorPairRow, selector, criterion, outputFeatures, featureScores);
+
+    freePairCache(&cache);
+    FREE_FUNC(classMI);
+    classMI = NULL;
+
+    return outputFeatures;
+}/*selectorSearch(uint,FEASTSelector*,FSCriterion*,uint[],double[])*/
+
+void freeFEASTSelector(FEASTSelector *selector) {
+    if (selector != NULL) {
+        if (selector->window != NULL) {
+            FREE_FUNC(selector->window);
+        }
+        FREE_FUNC(selector->numStates);
+        FREE_FUNC(selector->classOffsets);
+        FREE_FUNC(selector->pairOffsets);
+        FREE_FUNC(selector->stateSums);
+        FREE_FUNC(selector->counts);
+        FREE_FUNC(selector);
+        selector = NULL;
+    }
+}/*freeFEASTSelector(FEASTSelector*)*/
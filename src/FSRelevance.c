@@ -0,0 +1,143 @@
+/*******************************************************************************
+** FSRelevance.c
+** Implements the relevance pass which starts every FEAST algorithm, computing
+** the mutual information between each feature and the class. The features are
+** handed out to the threads in small chunks so columns with many states don't
+** leave the other threads idle. Also provides the ordering of the features by
+** relevance used by the lazy searches.
+**
+** Author: Adam Pocock
+** Created: 17/10/2026
+**
+** Part of the FEAture Selection Toolbox (FEAST), please reference
+** "Conditional Likelihood Maximisation: A Unifying Framework for Information
+** Theoretic Feature Selection"
+** G. Brown, A. Pocock, M.-J. Zhao, M. Lujan
+** Journal of Machine Learning Research (JMLR), 2012
+**
+** Please check www.github.com/Craigacp/FEAST for updates.
+** 
+** Copyright (c) 2010-2017, A. Pocock, G. Brown, The University of Manchester
+** All rights reserved.
+** 
+** Redistribution and use in source and binary forms, with or without modification,
+** are permitted provided that the following conditions are met:
+** 
+**   - Redistributions of source code must retain the above copyright notice, this 
+**     list of conditions and the following disclaimer.
+**   - Redistributions in binary form must reproduce the above copyright notice, 
+**     this list of conditions and the following disclaimer in the documentation 
+**     and/or other materials provided with the distribution.
+**   - Neither the name of The University of Manchester nor the names of its 
+**     contributors may be used to endorse or promote products derived from this 
+**     software without specific prior written permission.
+** 
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+** ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+** ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+** (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+** LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+** ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+** SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+*******************************************************************************/
+
+
+#include "FEAST/FSToolbox.h"
+#include "FSInternal.h"
+
+/* for qsort */
+#include <stdlib.h>
+
+/* MIToolbox includes */
+#include "MIToolbox/WeightedMutualInformation.h"
+
+typedef struct ScoredIndex {
+    double score;
+    int index;
+} ScoredIndex;
+
+static int compareScoredIndex(const void *first, const void *second) {
+    const ScoredIndex *a = (const ScoredIndex *) first;
+    const ScoredIndex *b = (const ScoredIndex *) second;
+
+    if (a->score > b->score) {
+        return -1;
+    } else if (a->score < b->score) {
+        return 1;
+    } else {
+        return a->index - b->index;
+    }
+}/*compareScoredIndex(void*,void*)*/
+
+void calculateClassMI(FSColumnSet *set, double *classMI, FSOptions *options) {
+    int numThreads = numberOfThreads(options);
+    int i;
+
+    if (set->classMI != NULL) {
+        /*the dataset has already done the relevance pass*/
+        memcpy(classMI, set->classMI, sizeof(double)*set->noOfFeatures);
+        return;
+    }
+
+    #pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(dynamic,FS_CHUNK_SIZE)
+    for (i = 0; i < set->noOfFeatures; i++) {
+        /*double calcColumnMI(FSColumn *firstColumn, FSColumn *secondColumn, int vectorLength);*/
+        classMI[i] = calcColumnMI(set->features + i, &(set->classColumn), set->noOfSamples);
+    }/*for noOfFeatures - filling classMI*/
+}/*calculateClassMI(FSColumnSet*,double[],FSOptions*)*/
+
+void calculateEntropies(FSColumnSet *set, double *entropies, FSOptions *options) {
+    int numThreads = numberOfThreads(options);
+    int i;
+
+    if (set->entropies != NULL) {
+        /*the dataset has already calculated the entropies*/
+        memcpy(entropies, set->entropies, sizeof(double)*(set->noOfFeatures+1));
+        return;
+    }
+
+    #pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(dynamic,FS_CHUNK_SIZE)
+    for (i = 0; i < set->noOfFeatures; i++) {
+        /*double calcColumnEntropy(FSColumn *column, int vectorLength);*/
+        entropies[i] = calcColumnEntropy(set->features + i, set->noOfSamples);
+    }/*for noOfFeatures - filling entropies*/
+
+    entropies[set->noOfFeatures] = calcColumnEntropy(&(set->classColumn), set->noOfSamples);
+}/*calculateEntropies(FSColumnSet*,double[],FSOptions*)*/
+
+void calculateWeightedClassMI(uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, double *classMI, FSOptions *options) {
+    int numThreads = numberOfThreads(options);
+    int i;
+
+    #pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(dynamic,FS_CHUNK_SIZE)
+    for (i = 0; i < noOfFeatures; i++) {
+        /*double calcWeightedMutualInformation(uint *firstVector, uint *secondVector, double *weightVector, int vectorLength);*/
+        classMI[i] = calcWeightedMutualInformation(featureMatrix[i], classColumn, weightVector, noOfSamples);
+    }/*for noOfFeatures - filling classMI*/
+}/*calculateWeightedClassMI(uint,uint,uint[][],uint[],double[],double[],FSOptions*)*/
+
+int* rankByScore(double *scores, int length) {
+    ScoredIndex *pairs = (ScoredIndex *) checkedCalloc(length,sizeof(ScoredIndex));
+    int *order = (int *) checkedCalloc(length,sizeof(int));
+    int i;
+
+    for (i = 0; i < length; i++) {
+        pairs[i].score = scores[i];
+        pairs[i].index = i;
+    }
+
+    qsort(pairs, length, sizeof(ScoredIndex), compareScoredIndex);
+
+    for (i = 0; i < length; i++) {
+        order[i] = pairs[i].index;
+    }
+
+    FREE_FUNC(pairs);
+    pairs = NULL;
+
+    return order;
+}/*rankByScore(double[],int)*/
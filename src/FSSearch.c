@@ -0,0 +1,1152 @@
+/*******************************************************************************
+** FSSearch.c
+** Implements FEASTSearch, a forward search which keeps its state between
+** calls so it can be extended to more features, or saved and reloaded.
+**
+** Author: Adam Pocock
+** Created: 17/10/2026
+**
+** Part of the FEAture Selection Toolbox (FEAST), please reference
+** "Conditional Likelihood Maximisation: A Unifying Framework for Information
+** Theoretic Feature Selection"
+** G. Brown, A. Pocock, M.-J. Zhao, M. Lujan
+** Journal of Machine Learning Research (JMLR), 2012
+**
+** Please check www.github.com/Craigacp/FEAST for updates.
+** 
+** Copyright (c) 2010-2017, A. Pocock, G. Brown, The University of Manchester
+** All rights reserved.
+** 
+** Redistribution and use in source and binary forms, with or without modification,
+** are permitted provided that the following conditions are met:
+** 
+**   - Redistributions of source code must retain the above copyright notice, this 
+**     list of conditions and the following disclaimer.
+**   - Redistributions in binary form must reproduce the above copyright notice, 
+**     this list of conditions and the following disclaimer in the documentation 
+**     and/or other materials provided with the distribution.
+**   - Neither the name of The University of Manchester nor the names of its 
+**     contributors may be used to endorse or promote products derived from this 
+**     software without specific prior written permission.
+** 
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+** ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+** ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+** (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+** LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+** ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+** SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+*******************************************************************************/
+
+
+/*fileno, fsync and clock_gettime need the POSIX definitions*/
+#define _POSIX_C_SOURCE 200112L
+
+#include "FEAST/FSSearch.h"
+#include "FEAST/FSToolbox.h"
+#include "FSInternal.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #define FS_SYNC_FILES
+  #define FS_MONOTONIC_CLOCK
+  #include <errno.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+/* MIToolbox includes */
+#include "MIToolbox/ArrayOperations.h"
+
+/*the magic string, then version, criterion, noOfSamples, noOfFeatures, noOfSelected, finished, conditionNumStates and fingerprint*/
+#define FS_SEARCH_MAGIC "FEASTSRC"
+#define FS_SEARCH_MAGIC_LENGTH 8
+#define FS_SEARCH_HEADER_FIELDS 8
+#define FS_SEARCH_VERSION 2
+
+/*the FNV-1a offset basis and prime used by the dataset fingerprint*/
+#define FS_FNV_OFFSET 2166136261U
+#define FS_FNV_PRIME 16777619U
+
+/*the alignment of each block carved from a search's storage or a workspace*/
+#define FS_WORKSPACE_ALIGNMENT 16
+
+/*******************************************************************************
+** outputFeatures and featureScores hold the noOfSelected features chosen so
+** far, in search set indices. runningScores holds the sum (or for CMIM the
+** minimum) of each candidate's terms, and lastUsedFeature the number of
+** selected features CMIM has compared each candidate against.
+** candidateScores is scratch space for the scores of one round.
+**
+** conditionVector holds the joint state of the selected features for CondMI,
+** and is NULL for the other criteria. finished is set once CondMI finds no
+** candidate which adds any information.
+**
+** fingerprint identifies the dataset the search was started on, and
+** verified is set once it has been checked against the dataset in use.
+** checkpointName is the file the search is checkpointed to, NULL if it isn't,
+** written every checkpointRounds rounds or checkpointSeconds seconds.
+** timeLimit is the number of seconds a call may run for, zero if it isn't
+** limited, and progress is called with progressData after every round if it
+** isn't NULL.
+**
+** The arrays are carved from one block by layoutSearch(). storage is that
+** block, or NULL if it belongs to a caller's workspace.
+*******************************************************************************/
+struct FEASTSearch {
+    FSCriterion criterion;
+    uint noOfSamples;
+    uint noOfFeatures;
+    uint noOfSelected;
+    int finished;
+    double *classMI;
+    uint *outputFeatures;
+    double *featureScores;
+    char *selectedFeatures;
+    double *runningScores;
+    uint *lastUsedFeature;
+    double *candidateScores;
+    uint *conditionVector;
+    uint *selectedVector;
+    int conditionNumStates;
+    uint fingerprint;
+    int verified;
+    char *checkpointName;
+    uint checkpointRounds;
+    double checkpointSeconds;
+    double timeLimit;
+    FSProgressFunction progress;
+    void *progressData;
+    void *storage;
+};
+
+/*******************************************************************************
+** carveBlock() returns the block of size bytes at *offset from base, and
+** moves *offset past it, keeping every block aligned for any of the types
+** stored. If base is NULL it only measures, returning NULL.
+*******************************************************************************/
+static void* carveBlock(char *base, size_t *offset, size_t size) {
+    void *block = base == NULL ? NULL : base + *offset;
+
+    *offset += ((size + FS_WORKSPACE_ALIGNMENT - 1) / FS_WORKSPACE_ALIGNMENT) * FS_WORKSPACE_ALIGNMENT;
+
+    return block;
+}/*carveBlock(char*,size_t*,size_t)*/
+
+/*******************************************************************************
+** layoutSearch() carves the arrays of a search from base starting at *offset,
+** and sets the fields which describe the search. The arrays aren't cleared.
+*******************************************************************************/
+static void layoutSearch(FEASTSearch *search, char *base, size_t *offset, FSCriterion *criterion, uint noOfSamples, uint noOfFeatures) {
+    size_t noOfEntries = (size_t) noOfFeatures + 1;
+
+    search->criterion = *criterion;
+    search->noOfSamples = noOfSamples;
+    search->noOfFeatures = noOfFeatures;
+    search->noOfSelected = 0;
+    search->finished = 0;
+    search->classMI = (double *) carveBlock(base, offset, noOfEntries * sizeof(double));
+    search->featureScores = (double *) carveBlock(base, offset, noOfEntries * sizeof(double));
+    search->runningScores = (double *) carveBlock(base, offset, noOfEntries * sizeof(double));
+    search->candidateScores = (double *) carveBlock(base, offset, noOfEntries * sizeof(double));
+    search->outputFeatures = (uint *) carveBlock(base, offset, noOfEntries * sizeof(uint));
+    search->lastUsedFeature = (uint *) carveBlock(base, offset, noOfEntries * sizeof(uint));
+    search->selectedFeatures = (char *) carveBlock(base, offset, noOfEntries * sizeof(char));
+
+    if (criterion->criterion == FS_CONDMI) {
+        search->conditionVector = (uint *) carveBlock(base, offset, ((size_t) noOfSamples + 1) * sizeof(uint));
+        search->selectedVector = (uint *) carveBlock(base, offset, ((size_t) noOfSamples + 1) * sizeof(uint));
+    } else {
+        search->conditionVector = NULL;
+        search->selectedVector = NULL;
+    }
+    search->conditionNumStates = 0;
+    search->fingerprint = 0;
+    search->verified = 0;
+    search->checkpointName = NULL;
+    search->checkpointRounds = 0;
+    search->checkpointSeconds = 0.0;
+    search->timeLimit = 0.0;
+    search->progress = NULL;
+    search->progressData = NULL;
+    search->storage = NULL;
+}/*layoutSearch(FEASTSearch*,char*,size_t*,FSCriterion*,uint,uint)*/
+
+static FEASTSearch* allocateSearch(FSCriterion *criterion, uint noOfSamples, uint noOfFeatures) {
+    FEASTSearch *search = (FEASTSearch *) checkedCalloc(1,sizeof(FEASTSearch));
+    size_t storageSize = 0;
+    void *storage;
+
+    layoutSearch(search, NULL, &storageSize, criterion, noOfSamples, noOfFeatures);
+    storage = checkedCalloc(storageSize,sizeof(char));
+    storageSize = 0;
+    layoutSearch(search, (char *) storage, &storageSize, criterion, noOfSamples, noOfFeatures);
+    search->storage = storage;
+
+    return search;
+}/*allocateSearch(FSCriterion*,uint,uint)*/
+
+/*******************************************************************************
+** wallClock() returns the elapsed time in seconds from an arbitrary point.
+** The monotonic clock isn't moved by changes to the system time. Where it
+** isn't available the calendar time is used, to the nearest second.
+*******************************************************************************/
+static double wallClock(void) {
+#ifdef FS_MONOTONIC_CLOCK
+    struct timespec now;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &now) == 0) {
+        return now.tv_sec + now.tv_nsec * 1e-9;
+    }
+#endif
+    return (double) time(NULL);
+}/*wallClock(void)*/
+
+/*******************************************************************************
+** columnSetFingerprint() hashes the dimensions, the number of states and the
+** values of every column of a set, and the row counts if the rows have been
+** collapsed, with 32 bit FNV-1a. Each column is hashed on its own and the
+** column hashes are combined in index order, so the result doesn't depend on
+** the number of threads.
+*******************************************************************************/
+static uint columnSetFingerprint(FSColumnSet *set, int numThreads) {
+    uint *columnHashes = (uint *) checkedCalloc(set->noOfFeatures + 2,sizeof(uint));
+    uint fingerprint = FS_FNV_OFFSET;
+    int i;
+
+    #pragma omp parallel num_threads(numThreads) if (numThreads > 1)
+    {
+        int block[FS_BLOCK_SIZE];
+        FSColumn *column;
+        uint hash;
+        int start, length, j;
+
+        #pragma omp for schedule(dynamic)
+        for (i = 0; i <= (int) set->noOfFeatures; i++) {
+            column = i < (int) set->noOfFeatures ? set->features + i : &(set->classColumn);
+            hash = FS_FNV_OFFSET;
+            for (start = 0; start < (int) set->noOfSamples; start += FS_BLOCK_SIZE) {
+                length = (int) set->noOfSamples - start < FS_BLOCK_SIZE ? (int) set->noOfSamples - start : FS_BLOCK_SIZE;
+                loadColumnBlock(column, start, length, block);
+                for (j = 0; j < length; j++) {
+                    hash = (hash ^ (uint) block[j]) * FS_FNV_PRIME;
+                }
+            }
+            columnHashes[i] = (hash ^ (uint) column->numStates) * FS_FNV_PRIME;
+        }/*for each column*/
+    }/*parallel hashing of the columns*/
+
+    fingerprint = (fingerprint ^ set->noOfSamples) * FS_FNV_PRIME;
+    fingerprint = (fingerprint ^ set->noOfFeatures) * FS_FNV_PRIME;
+    for (i = 0; i <= (int) set->noOfFeatures; i++) {
+        fingerprint = (fingerprint ^ columnHashes[i]) * FS_FNV_PRIME;
+    }
+    if (set->rowCounts != NULL) {
+        for (i = 0; i < (int) set->noOfSamples; i++) {
+            fingerprint = (fingerprint ^ set->rowCounts[i]) * FS_FNV_PRIME;
+        }
+    }
+
+    FREE_FUNC(columnHashes);
+    columnHashes = NULL;
+
+    return fingerprint;
+}/*columnSetFingerprint(FSColumnSet*,int)*/
+
+/*******************************************************************************
+** threadScratch() returns the calling thread's buffers from scratch, which
+** holds one FSScratch for each thread of the round, or NULL if it is NULL.
+*******************************************************************************/
+static FSScratch* threadScratch(FSScratch *scratch) {
+    return scratch == NULL ? NULL : scratch + threadIndex();
+}/*threadScratch(FSScratch[])*/
+
+/*******************************************************************************
+** firstRound() selects the feature with the highest class MI, as every
+** criterion does, and sets up the running scores.
+*******************************************************************************/
+static int firstRound(FEASTSearch *search, FSColumnSet *set) {
+    double maxMI = -1.0;
+    int maxMICounter = -1;
+    uint i;
+
+    for (i = 0; i < search->noOfFeatures; i++) {
+        if (search->classMI[i] > maxMI) {
+            maxMI = search->classMI[i];
+            maxMICounter = i;
+        }/*if bigger than current maximum*/
+    }/*for noOfFeatures - finding the most relevant feature*/
+
+    if (maxMICounter == -1) {
+        search->finished = 1;
+        return -1;
+    }
+
+    for (i = 0; i < search->noOfFeatures; i++) {
+        search->runningScores[i] = startingRunningScore(search->criterion.criterion, search->classMI[i]);
+    }
+
+    if (search->criterion.criterion == FS_CONDMI) {
+        unpackColumn(set->features + maxMICounter, search->noOfSamples, search->conditionVector);
+        search->conditionNumStates = set->features[maxMICounter].numStates;
+    }
+
+    search->selectedFeatures[maxMICounter] = 1;
+    search->outputFeatures[0] = maxMICounter;
+    search->featureScores[0] = maxMI;
+    search->noOfSelected = 1;
+
+    return 0;
+}/*firstRound(FEASTSearch*,FSColumnSet*)*/
+
+/*******************************************************************************
+** cmimRound() runs one round of CMIM as columnCMIM() does, only bringing a
+** candidate's partial score up to date while it could still beat the best
+** exact score, with the threads sharing that score.
+*******************************************************************************/
+static int cmimRound(FEASTSearch *search, FSColumnSet *set, int numThreads, FSScratch *scratch) {
+    uint i = search->noOfSelected;
+    double *partialScores = search->runningScores;
+    double score;
+    int currentHighestFeature;
+
+    startingCandidate(FS_CMIM, &score, &currentHighestFeature);
+
+    #pragma omp parallel num_threads(numThreads) if (numThreads > 1)
+    {
+        JointStatistics stats;
+        double bound;
+        uint currentFeature;
+        int j;
+
+        #pragma omp for schedule(dynamic,FS_CHUNK_SIZE)
+        for (j = 0; j < search->noOfFeatures; j++) {
+            if (!search->selectedFeatures[j]) {
+                /*score is the best exact score any thread has found so far, so it only grows*/
+                #pragma omp atomic read
+                bound = score;
+
+                while ((partialScores[j] >= bound) && (search->lastUsedFeature[j] < i)) {
+                    /*JointStatistics scratchJointStatistics(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn, int vectorLength, FSScratch *scratch);*/
+                    currentFeature = search->outputFeatures[search->lastUsedFeature[j]];
+                    stats = scratchJointStatistics(set->features + currentFeature,set->features + j,&(set->classColumn),search->noOfSamples,threadScratch(scratch));
+                    scoreCandidate(&(search->criterion), criterionTerm(&(search->criterion), &stats), search->classMI[j], i, partialScores + j);
+                    search->lastUsedFeature[j] += 1;
+
+                    #pragma omp atomic read
+                    bound = score;
+                }/*while partial score not below score & not reached last feature*/
+
+                if ((search->lastUsedFeature[j] == i) && (partialScores[j] >= bound)) {
+                    #pragma omp critical (cmimRoundScore)
+                    {
+                        if (BETTER_CANDIDATE(partialScores[j],j,score,currentHighestFeature)) {
+                            #pragma omp atomic write
+                            score = partialScores[j];
+                            currentHighestFeature = j;
+                        }
+                    }/*raise the shared score*/
+                }/*if the partial score is exact and may still win*/
+            }
+        }/*for number of features*/
+    }/*parallel scoring of the candidates*/
+
+    search->selectedFeatures[currentHighestFeature] = 1;
+    search->outputFeatures[i] = currentHighestFeature;
+    search->featureScores[i] = score;
+    search->noOfSelected++;
+
+    return 0;
+}/*cmimRound(FEASTSearch*,FSColumnSet*,int,FSScratch*)*/
+
+/*******************************************************************************
+** scratchMergeCondition() merges selectedVector into conditionVector as
+** mergeArrays() does, numbering the joint states in the order they are first
+** seen, but maps them with the scratch stateMap, which it leaves zeroed.
+*******************************************************************************/
+static void scratchMergeCondition(FEASTSearch *search, FSScratch *scratch) {
+    int selectedNumStates = maxState(search->selectedVector, search->noOfSamples);
+    int stateCount = 1;
+    uint *jointStates = scratch->pairVector;
+    uint i;
+
+    for (i = 0; i < search->noOfSamples; i++) {
+        jointStates[i] = search->selectedVector[i] + selectedNumStates * search->conditionVector[i];
+        if (scratch->stateMap[jointStates[i]] == 0) {
+            scratch->stateMap[jointStates[i]] = stateCount;
+            stateCount++;
+        }
+        search->conditionVector[i] = scratch->stateMap[jointStates[i]];
+    }
+
+    for (i = 0; i < search->noOfSamples; i++) {
+        scratch->stateMap[jointStates[i]] = 0;
+    }
+}/*scratchMergeCondition(FEASTSearch*,FSScratch*)*/
+
+/*******************************************************************************
+** condMIRound() runs one round of CondMI, scoring each candidate against the
+** joint state of the selected features and merging the winner into it.
+*******************************************************************************/
+static int condMIRound(FEASTSearch *search, FSColumnSet *set, int numThreads, FSScratch *scratch) {
+    uint i = search->noOfSelected;
+    double score;
+    int currentHighestFeature;
+    FSColumn conditionColumn;
+    int j;
+
+    conditionColumn.data = search->conditionVector;
+    conditionColumn.width = sizeof(uint);
+    conditionColumn.numStates = search->conditionNumStates;
+    conditionColumn.bits = NULL;
+    conditionColumn.rowIndices = NULL;
+    conditionColumn.noOfEntries = search->noOfSamples;
+    conditionColumn.stateCounts = NULL;
+    conditionColumn.rowCounts = set->rowCounts;
+
+    #pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(dynamic,FS_CHUNK_SIZE)
+    for (j = 0; j < search->noOfFeatures; j++) {
+        JointStatistics stats;
+
+        if (!search->selectedFeatures[j]) {
+            /*JointStatistics scratchJointStatistics(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn, int vectorLength, FSScratch *scratch);*/
+            stats = scratchJointStatistics(&conditionColumn, set->features + j, &(set->classColumn), search->noOfSamples, threadScratch(scratch));
+            search->candidateScores[j] = scoreCandidate(&(search->criterion), criterionTerm(&(search->criterion), &stats), search->classMI[j], i, search->runningScores + j);
+        }
+    }/*for number of features*/
+
+    startingCandidate(FS_CONDMI, &score, &currentHighestFeature);
+    for (j = 0; j < search->noOfFeatures; j++) {
+        if (!search->selectedFeatures[j] && BETTER_CANDIDATE(search->candidateScores[j],j,score,currentHighestFeature)) {
+            score = search->candidateScores[j];
+            currentHighestFeature = j;
+        }
+    }
+
+    if (currentHighestFeature == -1) {
+        /*nothing adds information, and nothing will in any later round*/
+        search->finished = 1;
+        return -1;
+    }
+
+    search->selectedFeatures[currentHighestFeature] = 1;
+    search->outputFeatures[i] = currentHighestFeature;
+    search->featureScores[i] = score;
+    search->noOfSelected++;
+
+    unpackColumn(set->features + currentHighestFeature, search->noOfSamples, search->selectedVector);
+    if (scratch == NULL) {
+        mergeArrays(search->selectedVector, search->conditionVector, search->conditionVector, search->noOfSamples);
+    } else {
+        scratchMergeCondition(search, scratch);
+    }
+    search->conditionNumStates = maxState(search->conditionVector, search->noOfSamples);
+
+    return 0;
+}/*condMIRound(FEASTSearch*,FSColumnSet*,int,FSScratch*)*/
+
+/*******************************************************************************
+** pairwiseRound() runs one round of the criteria which add one pairwise term
+** per selected feature, updating the running scores as batchSearch() does.
+*******************************************************************************/
+static int pairwiseRound(FEASTSearch *search, FSColumnSet *set, int numThreads, FSScratch *scratch) {
+    uint i = search->noOfSelected;
+    uint lastFeature = search->outputFeatures[i-1];
+    int criterion = search->criterion.criterion;
+    double score;
+    int currentHighestFeature;
+    int j;
+
+    #pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(dynamic,FS_CHUNK_SIZE)
+    for (j = 0; j < search->noOfFeatures; j++) {
+        JointStatistics stats;
+        double term = 0.0;
+
+        if (!search->selectedFeatures[j]) {
+            if (criterion == FS_MRMR_D) {
+                /*the redundancy is the same term columnmRMR_D() uses, so the scores match it exactly*/
+                /*double scratchColumnMI(FSColumn *firstColumn, FSColumn *secondColumn, int vectorLength, FSScratch *scratch);*/
+                term = scratchColumnMI(set->features + lastFeature, set->features + j, search->noOfSamples, threadScratch(scratch));
+            } else if (criterion != FS_MIM) {
+                /*JointStatistics scratchJointStatistics(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn, int vectorLength, FSScratch *scratch);*/
+                stats = scratchJointStatistics(set->features + lastFeature, set->features + j, &(set->classColumn), search->noOfSamples, threadScratch(scratch));
+                term = criterionTerm(&(search->criterion), &stats);
+            }
+            search->candidateScores[j] = scoreCandidate(&(search->criterion), term, search->classMI[j], i, search->runningScores + j);
+        }/*if j is unselected*/
+    }/*for number of features*/
+
+    startingCandidate(criterion, &score, &currentHighestFeature);
+    for (j = 0; j < search->noOfFeatures; j++) {
+        if (!search->selectedFeatures[j] && BETTER_CANDIDATE(search->candidateScores[j],j,score,currentHighestFeature)) {
+            score = search->candidateScores[j];
+            currentHighestFeature = j;
+        }
+    }
+
+    search->selectedFeatures[currentHighestFeature] = 1;
+    search->outputFeatures[i] = currentHighestFeature;
+    search->featureScores[i] = score;
+    search->noOfSelected++;
+
+    return 0;
+}/*pairwiseRound(FEASTSearch*,FSColumnSet*,int,FSScratch*)*/
+
+/*******************************************************************************
+** searchRound() selects the next feature. Returns 0, or -1 if no feature
+** could be selected. scratch is NULL, or holds one FSScratch for each of the
+** numThreads threads, each used by one thread's candidates.
+*******************************************************************************/
+static int searchRound(FEASTSearch *search, FSColumnSet *set, int numThreads, FSScratch *scratch) {
+    if (search->finished || (search->noOfSelected >= search->noOfFeatures)) {
+        return -1;
+    } else if (search->noOfSelected == 0) {
+        return firstRound(search, set);
+    } else if (search->criterion.criterion == FS_CMIM) {
+        return cmimRound(search, set, numThreads, scratch);
+    } else if (search->criterion.criterion == FS_CONDMI) {
+        return condMIRound(search, set, numThreads, scratch);
+    } else {
+        return pairwiseRound(search, set, numThreads, scratch);
+    }
+}/*searchRound(FEASTSearch*,FSColumnSet*,int,FSScratch*)*/
+
+FEASTSearch* startFEASTSearch(FEASTDataset *dataset, FSCriterion *criterion, FSOptions *options) {
+    FSColumnSet *set = searchColumnSet(dataset);
+    FEASTSearch *search = allocateSearch(criterion, set->noOfSamples, set->noOfFeatures);
+
+    calculateClassMI(set, search->classMI, options);
+    search->fingerprint = columnSetFingerprint(set, numberOfThreads(options));
+    search->verified = 1;
+
+    return search;
+}/*startFEASTSearch(FEASTDataset*,FSCriterion*,FSOptions*)*/
+
+/*******************************************************************************
+** writeSelection() writes the first count selected features into
+** outputFeatures and featureScores, with the dataset's feature indices.
+** count is at most the number of rounds run.
+*******************************************************************************/
+static void writeSelection(FEASTSearch *search, FEASTDataset *dataset, uint count, uint *outputFeatures, double *featureScores) {
+    memcpy(outputFeatures, search->outputFeatures, sizeof(uint)*count);
+    memcpy(featureScores, search->featureScores, sizeof(double)*count);
+    restoreFeatureIndices(dataset, count, outputFeatures, featureScores);
+}/*writeSelection(FEASTSearch*,FEASTDataset*,uint,uint[],double[])*/
+
+int continueFEASTSearch(uint k, FEASTSearch *search, FEASTDataset *dataset, uint *outputFeatures, double *featureScores, FSOptions *options) {
+    FSColumnSet *set = searchColumnSet(dataset);
+    uint searched = searchLength(dataset, k);
+    int numThreads = numberOfThreads(options);
+    int *condMIOutputs;
+    int status = FS_SEARCH_COMPLETE;
+    int checkpointFailed = 0;
+    uint lastCheckpoint = search->noOfSelected;
+    double startTime = wallClock();
+    double lastCheckpointTime = startTime;
+    uint *progressFeatures = NULL;
+    double *progressScores = NULL;
+    uint i;
+
+    if ((set->noOfSamples != search->noOfSamples) || (set->noOfFeatures != search->noOfFeatures)) {
+        return FS_SEARCH_WRONG_DATASET;
+    }
+
+    if (!search->verified) {
+        if (columnSetFingerprint(set, numThreads) != search->fingerprint) {
+            return FS_SEARCH_WRONG_DATASET;
+        }
+        search->verified = 1;
+    }
+
+    if (search->progress != NULL) {
+        progressFeatures = (uint *) checkedCalloc(searched + 1,sizeof(uint));
+        progressScores = (double *) checkedCalloc(searched + 1,sizeof(double));
+    }
+
+    while ((search->noOfSelected < searched) && (searchRound(search, set, numThreads, NULL) == 0)) {
+        if ((search->checkpointName != NULL)
+            && (((search->checkpointRounds > 0) && (search->noOfSelected - lastCheckpoint >= search->checkpointRounds))
+                || ((search->checkpointSeconds > 0.0) && (wallClock() - lastCheckpointTime >= search->checkpointSeconds)))) {
+            checkpointFailed = (saveFEASTSearch(search, search->checkpointName) != 0) || checkpointFailed;
+            lastCheckpoint = search->noOfSelected;
+            lastCheckpointTime = wallClock();
+        }
+
+        if (search->progress != NULL) {
+            writeSelection(search, dataset, search->noOfSelected, progressFeatures, progressScores);
+            if (search->progress(search->progressData, search->noOfSelected, progressFeatures, progressScores) && (search->noOfSelected < searched)) {
+                status = FS_SEARCH_CANCELLED;
+                break;
+            }
+        }
+
+        if ((search->timeLimit > 0.0) && (wallClock() - startTime >= search->timeLimit) && (search->noOfSelected < searched)) {
+            status = FS_SEARCH_TIMED_OUT;
+            break;
+        }
+    }/*while features remain to be selected*/
+
+    if ((search->checkpointName != NULL) && (search->noOfSelected != lastCheckpoint)) {
+        /*the rounds since the last checkpoint are saved so the run can be extended later*/
+        checkpointFailed = (saveFEASTSearch(search, search->checkpointName) != 0) || checkpointFailed;
+    }
+
+    if (status != FS_SEARCH_COMPLETE) {
+        /*only the prefix selected so far is returned*/
+        writeSelection(search, dataset, search->noOfSelected, outputFeatures, featureScores);
+    } else if (search->criterion.criterion == FS_CONDMI) {
+        condMIOutputs = (int *) checkedCalloc(k + 1,sizeof(int));
+        for (i = 0; i < searched; i++) {
+            if (i < search->noOfSelected) {
+                condMIOutputs[i] = search->outputFeatures[i];
+                featureScores[i] = search->featureScores[i];
+            } else {
+                condMIOutputs[i] = -1;
+                featureScores[i] = 0.0;
+            }
+        }
+        restoreConditionalIndices(dataset, k, condMIOutputs, featureScores);
+        for (i = 0; i < k; i++) {
+            outputFeatures[i] = (uint) condMIOutputs[i];
+        }
+        FREE_FUNC(condMIOutputs);
+        condMIOutputs = NULL;
+    } else {
+        memcpy(outputFeatures, search->outputFeatures, sizeof(uint)*searched);
+        memcpy(featureScores, search->featureScores, sizeof(double)*searched);
+        restoreFeatureIndices(dataset, k, outputFeatures, featureScores);
+    }
+
+    if (progressFeatures != NULL) {
+        FREE_FUNC(progressFeatures);
+        FREE_FUNC(progressScores);
+        progressFeatures = NULL;
+        progressScores = NULL;
+    }
+
+    return checkpointFailed ? FS_SEARCH_CHECKPOINT_FAILED : status;
+}/*continueFEASTSearch(uint,FEASTSearch*,FEASTDataset*,uint[],double[],FSOptions*)*/
+
+uint searchNoOfSelected(FEASTSearch *search) {
+    return search->noOfSelected;
+}/*searchNoOfSelected(FEASTSearch*)*/
+
+void setSearchCheckpoint(FEASTSearch *search, const char *fileName, uint everyRounds, double everySeconds) {
+    if (search->checkpointName != NULL) {
+        FREE_FUNC(search->checkpointName);
+        search->checkpointName = NULL;
+    }
+
+    if (fileName != NULL) {
+        search->checkpointName = (char *) checkedCalloc(strlen(fileName) + 1,sizeof(char));
+        strcpy(search->checkpointName, fileName);
+    }
+    search->checkpointRounds = everyRounds;
+    search->checkpointSeconds = everySeconds;
+}/*setSearchCheckpoint(FEASTSearch*,const char*,uint,double)*/
+
+void setSearchLimits(FEASTSearch *search, double timeLimit, FSProgressFunction progress, void *progressData) {
+    search->timeLimit = timeLimit;
+    search->progress = progress;
+    search->progressData = progressData;
+}/*setSearchLimits(FEASTSearch*,double,FSProgressFunction,void*)*/
+
+/*******************************************************************************
+** searchFileSize() returns the length of a saved search of noOfFeatures
+** features, which for CondMI also holds the condition of noOfSamples values.
+*******************************************************************************/
+static size_t searchFileSize(int criterion, uint noOfSamples, uint noOfFeatures) {
+    size_t size = FS_SEARCH_MAGIC_LENGTH + sizeof(uint) * FS_SEARCH_HEADER_FIELDS + 2 * sizeof(double);
+
+    size += (size_t) noOfFeatures * (3 * sizeof(double) + 2 * sizeof(uint));
+    if (criterion == FS_CONDMI) {
+        size += (size_t) noOfSamples * sizeof(uint);
+    }
+
+    return size;
+}/*searchFileSize(int,uint,uint)*/
+
+#ifdef FS_SYNC_FILES
+/*******************************************************************************
+** syncDirectory() flushes the directory holding fileName to disk, so a file
+** renamed into it survives a crash. Returns 0 on success.
+*******************************************************************************/
+static int syncDirectory(const char *fileName) {
+    const char *lastSlash = strrchr(fileName, '/');
+    char *dirName;
+    int dirFile, failed;
+
+    if (lastSlash == NULL) {
+        dirName = (char *) checkedCalloc(2,sizeof(char));
+        strcpy(dirName, ".");
+    } else {
+        /*keep the slash if the file is in the root directory*/
+        size_t length = (lastSlash == fileName) ? 1 : (size_t) (lastSlash - fileName);
+        dirName = (char *) checkedCalloc(length + 1,sizeof(char));
+        memcpy(dirName, fileName, length);
+    }
+
+    dirFile = open(dirName, O_RDONLY);
+    FREE_FUNC(dirName);
+    dirName = NULL;
+
+    if (dirFile < 0) {
+        return -1;
+    }
+
+    /*some file systems can't sync a directory, and don't need to*/
+    failed = (fsync(dirFile) != 0) && (errno != EINVAL);
+    failed = (close(dirFile) != 0) || failed;
+
+    return failed ? -1 : 0;
+}/*syncDirectory(const char*)*/
+#endif
+
+int saveFEASTSearch(FEASTSearch *search, const char *fileName) {
+    /*the search is written to a temporary file which then replaces fileName*/
+    char *tempName = (char *) checkedCalloc(strlen(fileName) + 5,sizeof(char));
+    FILE *file;
+    uint header[FS_SEARCH_HEADER_FIELDS];
+    double params[2];
+    size_t noOfFeatures = search->noOfFeatures;
+    int failed;
+
+    strcpy(tempName, fileName);
+    strcat(tempName, ".tmp");
+
+    file = fopen(tempName, "wb");
+    if (file == NULL) {
+        FREE_FUNC(tempName);
+        tempName = NULL;
+        return -1;
+    }
+
+    header[0] = FS_SEARCH_VERSION;
+    header[1] = (uint) search->criterion.criterion;
+    header[2] = search->noOfSamples;
+    header[3] = search->noOfFeatures;
+    header[4] = search->noOfSelected;
+    header[5] = (uint) search->finished;
+    header[6] = (uint) search->conditionNumStates;
+    header[7] = search->fingerprint;
+    params[0] = search->criterion.betaParam;
+    params[1] = search->criterion.gammaParam;
+
+    failed = (fwrite(FS_SEARCH_MAGIC, 1, FS_SEARCH_MAGIC_LENGTH, file) != FS_SEARCH_MAGIC_LENGTH)
+             || (fwrite(header, sizeof(uint), FS_SEARCH_HEADER_FIELDS, file) != FS_SEARCH_HEADER_FIELDS)
+             || (fwrite(params, sizeof(double), 2, file) != 2)
+             || (fwrite(search->classMI, sizeof(double), noOfFeatures, file) != noOfFeatures)
+             || (fwrite(search->runningScores, sizeof(double), noOfFeatures, file) != noOfFeatures)
+             || (fwrite(search->featureScores, sizeof(double), noOfFeatures, file) != noOfFeatures)
+             || (fwrite(search->outputFeatures, sizeof(uint), noOfFeatures, file) != noOfFeatures)
+             || (fwrite(search->lastUsedFeature, sizeof(uint), noOfFeatures, file) != noOfFeatures);
+
+    if (!failed && (search->conditionVector != NULL)) {
+        failed = fwrite(search->conditionVector, sizeof(uint), search->noOfSamples, file) != search->noOfSamples;
+    }
+
+    failed = (fflush(file) != 0) || failed;
+#ifdef FS_SYNC_FILES
+    /*the data must be on disk before the rename makes it the checkpoint*/
+    failed = (fsync(fileno(file)) != 0) || failed;
+#endif
+    failed = (fclose(file) != 0) || failed;
+
+    if (!failed) {
+#ifdef _WIN32
+        /*rename won't replace an existing file on Windows*/
+        failed = MoveFileExA(tempName, fileName, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) == 0;
+#else
+        failed = rename(tempName, fileName) != 0;
+#endif
+#ifdef FS_SYNC_FILES
+        /*the rename is only durable once the directory entry is on disk*/
+        failed = failed || (syncDirectory(fileName) != 0);
+#endif
+    }
+
+    if (failed) {
+        remove(tempName);
+    }
+
+    FREE_FUNC(tempName);
+    tempName = NULL;
+
+    return failed ? -1 : 0;
+}/*saveFEASTSearch(FEASTSearch*,const char*)*/
+
+FEASTSearch* loadFEASTSearch(const char *fileName) {
+    FILE *file = fopen(fileName, "rb");
+    char magic[FS_SEARCH_MAGIC_LENGTH];
+    uint header[FS_SEARCH_HEADER_FIELDS];
+    double params[2];
+    FSCriterion criterion;
+    FEASTSearch *search = NULL;
+    size_t noOfFeatures, fileSize;
+    long fileEnd;
+    int failed;
+    uint i;
+
+    if (file == NULL) {
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    fileEnd = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    failed = (fileEnd < 0)
+             || (fread(magic, 1, FS_SEARCH_MAGIC_LENGTH, file) != FS_SEARCH_MAGIC_LENGTH)
+             || (memcmp(magic, FS_SEARCH_MAGIC, FS_SEARCH_MAGIC_LENGTH) != 0)
+             || (fread(header, sizeof(uint), FS_SEARCH_HEADER_FIELDS, file) != FS_SEARCH_HEADER_FIELDS)
+             || (fread(params, sizeof(double), 2, file) != 2)
+             || (header[0] != FS_SEARCH_VERSION) || (header[1] > FS_BETAGAMMA) || (header[4] > header[3])
+             || (header[2] > INT_MAX) || (header[3] > INT_MAX) || (header[5] > 1) || (header[6] > INT_MAX)
+             || ((header[1] != FS_CONDMI) && (header[6] != 0));
+
+    if (!failed) {
+        /*the sizes are checked against the file before anything is allocated*/
+        fileSize = (size_t) fileEnd;
+        failed = fileSize != searchFileSize((int) header[1], header[2], header[3]);
+    }
+
+    if (!failed) {
+        criterion.criterion = (int) header[1];
+        criterion.betaParam = params[0];
+        criterion.gammaParam = params[1];
+        search = allocateSearch(&criterion, header[2], header[3]);
+        search->noOfSelected = header[4];
+        search->finished = (int) header[5];
+        search->conditionNumStates = (int) header[6];
+        search->fingerprint = header[7];
+        noOfFeatures = search->noOfFeatures;
+
+        failed = (fread(search->classMI, sizeof(double), noOfFeatures, file) != noOfFeatures)
+                 || (fread(search->runningScores, sizeof(double), noOfFeatures, file) != noOfFeatures)
+                 || (fread(search->featureScores, sizeof(double), noOfFeatures, file) != noOfFeatures)
+                 || (fread(search->outputFeatures, sizeof(uint), noOfFeatures, file) != noOfFeatures)
+                 || (fread(search->lastUsedFeature, sizeof(uint), noOfFeatures, file) != noOfFeatures);
+
+        if (!failed && (search->conditionVector != NULL)) {
+            failed = fread(search->conditionVector, sizeof(uint), search->noOfSamples, file) != search->noOfSamples;
+            /*the condition's states index the counting tables*/
+            for (i = 0; !failed && (search->noOfSelected > 0) && (i < search->noOfSamples); i++) {
+                failed = search->conditionVector[i] >= (uint) search->conditionNumStates;
+            }
+        }
+
+        for (i = 0; !failed && (i < search->noOfSelected); i++) {
+            if ((search->outputFeatures[i] >= search->noOfFeatures) || search->selectedFeatures[search->outputFeatures[i]]) {
+                failed = 1;
+            } else {
+                search->selectedFeatures[search->outputFeatures[i]] = 1;
+            }
+        }
+
+        /*CMIM indexes the selected features by how far each candidate has got*/
+        for (i = 0; !failed && (i < search->noOfFeatures); i++) {
+            failed = search->lastUsedFeature[i] > search->noOfSelected;
+        }
+    }
+
+    fclose(file);
+
+    if (failed && (search != NULL)) {
+        freeFEASTSearch(search);
+        search = NULL;
+    }
+
+    return search;
+}/*loadFEASTSearch(const char*)*/
+
+FEASTSearch* resumeFEASTSearch(const char *fileName, FEASTDataset *dataset, FSOptions *options) {
+    FSColumnSet *set = searchColumnSet(dataset);
+    FEASTSearch *search = loadFEASTSearch(fileName);
+
+    if ((search != NULL)
+        && ((set->noOfSamples != search->noOfSamples) || (set->noOfFeatures != search->noOfFeatures)
+            || (columnSetFingerprint(set, numberOfThreads(options)) != search->fingerprint))) {
+        freeFEASTSearch(search);
+        search = NULL;
+    }
+
+    if (search != NULL) {
+        search->verified = 1;
+    }
+
+    return search;
+}/*resumeFEASTSearch(const char*,FEASTDataset*,FSOptions*)*/
+
+void freeFEASTSearch(FEASTSearch *search) {
+    if (search != NULL) {
+        if (search->checkpointName != NULL) {
+            FREE_FUNC(search->checkpointName);
+        }
+        FREE_FUNC(search->storage);
+        FREE_FUNC(search);
+        search = NULL;
+    }
+}/*freeFEASTSearch(FEASTSearch*)*/
+
+/*******************************************************************************
+** FSWorkspaceHeader starts every workspace, and records the bytes of the
+** workspace the last call left zeroed. The kernels reset the state map
+** entries they touch, so only the part of a call's state map outside that
+** range needs clearing, which is nothing when the sizes don't change. The
+** range is only trusted if the header has the magic value and the range lies
+** within the layout the last call used, which itself fits in the workspace,
+** so a workspace that was never zeroed costs one full clear.
+*******************************************************************************/
+#define FS_WORKSPACE_MAGIC 0x46535753UL
+
+typedef struct FSWorkspaceHeader {
+    unsigned long magic;
+    size_t layoutSize;
+    size_t zeroStart;
+    size_t zeroLength;
+} FSWorkspaceHeader;
+
+/*******************************************************************************
+** clearStateMap() zeroes the bytes from start to end of the workspace which
+** the header doesn't record as zeroed, then records them as zeroed by a call
+** laid out in layoutSize bytes of a workspaceSize byte workspace.
+*******************************************************************************/
+static void clearStateMap(FSWorkspaceHeader *header, char *base, size_t start, size_t end, size_t layoutSize, size_t workspaceSize) {
+    size_t zeroEnd;
+
+    if ((header->magic != FS_WORKSPACE_MAGIC) || (header->layoutSize > workspaceSize)
+        || (header->zeroLength > header->layoutSize) || (header->zeroStart > header->layoutSize - header->zeroLength)) {
+        header->zeroStart = 0;
+        header->zeroLength = 0;
+    }
+    zeroEnd = header->zeroStart + header->zeroLength;
+
+    if ((zeroEnd <= start) || (header->zeroStart >= end)) {
+        memset(base + start, 0, end - start);
+    } else {
+        if (header->zeroStart > start) {
+            memset(base + start, 0, header->zeroStart - start);
+        }
+        if (zeroEnd < end) {
+            memset(base + zeroEnd, 0, end - zeroEnd);
+        }
+    }
+
+    header->magic = FS_WORKSPACE_MAGIC;
+    header->layoutSize = layoutSize;
+    header->zeroStart = start;
+    header->zeroLength = end - start;
+}/*clearStateMap(FSWorkspaceHeader*,char*,size_t,size_t,size_t,size_t)*/
+
+/*******************************************************************************
+** layoutWorkspace() carves a search of noOfFeatures features with at most
+** numStates states each from base starting at offset, followed by an array of
+** noOfScratches FSScratch and their buffers. Returns the bytes needed, and
+** measures without writing anything if base is NULL.
+*******************************************************************************/
+static size_t layoutWorkspace(char *base, size_t offset, FSCriterion *criterion, uint noOfSamples, uint noOfFeatures, size_t numStates, size_t classNumStates, int noOfScratches, FEASTSearch **search, FSScratch **scratch) {
+    FEASTSearch measuredSearch;
+    FSScratch measuredScratch;
+    FSScratch *current;
+    /*CondMI numbers its condition's states from one, so it can have noOfSamples + 1*/
+    size_t firstNumStates = (criterion->criterion == FS_CONDMI) && ((size_t) noOfSamples + 1 > numStates) ? (size_t) noOfSamples + 1 : numStates;
+    size_t pairCapacity = firstNumStates * numStates < noOfSamples ? firstNumStates * numStates : noOfSamples;
+    size_t jointLength = pairCapacity * classNumStates;
+    int s;
+
+    if (jointLength < numStates * classNumStates + numStates + classNumStates) {
+        jointLength = numStates * classNumStates + numStates + classNumStates;
+    }
+    /*mRMR_D's redundancy is a two way table between features*/
+    if ((criterion->criterion == FS_MRMR_D) && (jointLength < numStates * numStates + 2 * numStates)) {
+        jointLength = numStates * numStates + 2 * numStates;
+    }
+
+    *search = (FEASTSearch *) carveBlock(base, &offset, sizeof(FEASTSearch));
+    layoutSearch(base == NULL ? &measuredSearch : *search, base, &offset, criterion, noOfSamples, noOfFeatures);
+    *scratch = (FSScratch *) carveBlock(base, &offset, noOfScratches * sizeof(FSScratch));
+
+    for (s = 0; s < noOfScratches; s++) {
+        current = base == NULL ? &measuredScratch : *scratch + s;
+        current->stateMap = (int *) carveBlock(base, &offset, firstNumStates * numStates * sizeof(int));
+        current->pairVector = (uint *) carveBlock(base, &offset, (noOfSamples + 2 * pairCapacity) * sizeof(uint));
+        current->jointCounts = (int *) carveBlock(base, &offset, jointLength * sizeof(int));
+        current->tableCounts = (int *) carveBlock(base, &offset, (pairCapacity + (firstNumStates + numStates) * (classNumStates + 1) + classNumStates) * sizeof(int));
+    }
+
+    return offset;
+}/*layoutWorkspace(char*,size_t,FSCriterion*,uint,uint,size_t,size_t,int,FEASTSearch**,FSScratch**)*/
+
+/*******************************************************************************
+** copySelection() copies the first k selected features and their scores of
+** search to outputFeatures and featureScores.
+*******************************************************************************/
+static void copySelection(FEASTSearch *search, uint k, uint *outputFeatures, double *featureScores) {
+    uint i;
+
+    for (i = 0; i < k; i++) {
+        if (i < search->noOfSelected) {
+            outputFeatures[i] = search->outputFeatures[i];
+            featureScores[i] = search->featureScores[i];
+        } else {
+            /*only CondMI stops early*/
+            outputFeatures[i] = (uint) -1;
+            featureScores[i] = 0.0;
+        }
+    }
+}/*copySelection(FEASTSearch*,uint,uint[],double[])*/
+
+int checkedSearch(uint k, FSColumnSet *set, FSCriterion *criterion, uint *outputFeatures, double *featureScores, int numThreads) {
+    FEASTSearch *search;
+    FSScratch *scratch;
+    char *block;
+    size_t numStates = 1, blockSize;
+    int i;
+
+    for (i = 0; i < (int) set->noOfFeatures; i++) {
+        if ((size_t) set->features[i].numStates > numStates) {
+            numStates = set->features[i].numStates;
+        }
+    }
+
+    blockSize = layoutWorkspace(NULL, 0, criterion, set->noOfSamples, set->noOfFeatures, numStates, set->classColumn.numStates, numThreads, &search, &scratch);
+    block = (char *) CALLOC_FUNC(blockSize,sizeof(char));
+    if (block == NULL) {
+        return FS_ERROR_MEMORY;
+    }
+
+    /*the block starts zeroed, so the state maps are clear*/
+    layoutWorkspace(block, 0, criterion, set->noOfSamples, set->noOfFeatures, numStates, set->classColumn.numStates, numThreads, &search, &scratch);
+    search->verified = 1;
+
+    #pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(dynamic,FS_CHUNK_SIZE)
+    for (i = 0; i < (int) set->noOfFeatures; i++) {
+        /*double scratchColumnMI(FSColumn *firstColumn, FSColumn *secondColumn, int vectorLength, FSScratch *scratch);*/
+        search->classMI[i] = scratchColumnMI(set->features + i, &(set->classColumn), set->noOfSamples, threadScratch(scratch));
+    }
+
+    while ((search->noOfSelected < k) && (searchRound(search, set, numThreads, scratch) == 0)) {
+        /*each round selects one more feature*/
+    }
+
+    copySelection(search, k, outputFeatures, featureScores);
+
+    FREE_FUNC(block);
+    block = NULL;
+
+    return FS_OK;
+}/*checkedSearch(uint,FSColumnSet*,FSCriterion*,uint[],double[],int)*/
+
+size_t searchWorkspaceSize(FSCriterion *criterion, uint noOfSamples, uint noOfFeatures, uint numStates, uint classNumStates) {
+    FEASTSearch *search;
+    FSScratch *scratch;
+    size_t offset = 0;
+
+    carveBlock(NULL, &offset, sizeof(FSWorkspaceHeader));
+    carveBlock(NULL, &offset, ((size_t) noOfFeatures + 1) * sizeof(FSColumn));
+
+    return layoutWorkspace(NULL, offset, criterion, noOfSamples, noOfFeatures, numStates < 1 ? 1 : numStates, classNumStates < 1 ? 1 : classNumStates, 1, &search, &scratch);
+}/*searchWorkspaceSize(FSCriterion*,uint,uint,uint,uint)*/
+
+int workspaceFeatureSelection(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, FSCriterion *criterion, uint *outputFeatures, double *featureScores, void *workspace, size_t workspaceSize) {
+    FEASTSearch *search;
+    FSScratch *scratch;
+    FSColumnSet set;
+    FSColumn *column;
+    FSWorkspaceHeader *header = (FSWorkspaceHeader *) workspace;
+    uint *inputVector;
+    uint maxValue;
+    size_t numStates = 1;
+    size_t columnsStart = 0, columnsSize, layoutSize;
+    uint i, j;
+
+    if ((criterion == NULL) || (criterion->criterion < FS_MIM) || (criterion->criterion > FS_BETAGAMMA)
+        || (featureMatrix == NULL) || (classColumn == NULL) || (outputFeatures == NULL) || (featureScores == NULL)
+        || (workspace == NULL) || (noOfSamples == 0) || (noOfSamples > INT_MAX) || (noOfFeatures > INT_MAX) || (k > noOfFeatures)) {
+        return FS_ERROR_ARGUMENT;
+    }
+
+    carveBlock(NULL, &columnsStart, sizeof(FSWorkspaceHeader));
+    columnsSize = columnsStart;
+    carveBlock(NULL, &columnsSize, ((size_t) noOfFeatures + 1) * sizeof(FSColumn));
+    if (columnsSize > workspaceSize) {
+        return FS_ERROR_WORKSPACE;
+    }
+
+    /*the columns are read in place, as createColumnSet() does without compact storage*/
+    set.noOfSamples = noOfSamples;
+    set.noOfFeatures = noOfFeatures;
+    set.features = (FSColumn *) ((char *) workspace + columnsStart);
+    set.storage = NULL;
+    set.bitmapStorage = NULL;
+    set.classMI = NULL;
+    set.entropies = NULL;
+    set.rowCounts = NULL;
+
+    for (i = 0; i <= noOfFeatures; i++) {
+        column = i < noOfFeatures ? set.features + i : &(set.classColumn);
+        inputVector = i < noOfFeatures ? featureMatrix[i] : classColumn;
+        if (inputVector == NULL) {
+            return FS_ERROR_ARGUMENT;
+        }
+
+        maxValue = 0;
+        for (j = 0; j < noOfSamples; j++) {
+            maxValue = inputVector[j] > maxValue ? inputVector[j] : maxValue;
+        }
+        if (maxValue >= INT_MAX) {
+            return FS_ERROR_STATES;
+        }
+
+        column->data = inputVector;
+        column->width = sizeof(uint);
+        column->numStates = maxValue + 1;
+        column->bits = NULL;
+        column->rowIndices = NULL;
+        column->noOfEntries = noOfSamples;
+        column->stateCounts = NULL;
+        column->rowCounts = NULL;
+
+        if ((i < noOfFeatures) && ((size_t) column->numStates > numStates)) {
+            numStates = column->numStates;
+        }
+    }
+
+    layoutSize = layoutWorkspace(NULL, columnsSize, criterion, noOfSamples, noOfFeatures, numStates, set.classColumn.numStates, 1, &search, &scratch);
+    if (layoutSize > workspaceSize) {
+        return FS_ERROR_WORKSPACE;
+    }
+
+    layoutWorkspace((char *) workspace, columnsSize, criterion, noOfSamples, noOfFeatures, numStates, set.classColumn.numStates, 1, &search, &scratch);
+    search->verified = 1;
+
+    /*only the state that the rounds read before writing is cleared*/
+    memset(search->selectedFeatures, 0, sizeof(char) * noOfFeatures);
+    memset(search->runningScores, 0, sizeof(double) * noOfFeatures);
+    memset(search->lastUsedFeature, 0, sizeof(uint) * noOfFeatures);
+    /*the state map is usually still zeroed from the last call*/
+    clearStateMap(header, (char *) workspace, (char *) scratch->stateMap - (char *) workspace, (char *) scratch->pairVector - (char *) workspace, layoutSize, workspaceSize);
+
+    for (i = 0; i < noOfFeatures; i++) {
+        /*double scratchColumnMI(FSColumn *firstColumn, FSColumn *secondColumn, int vectorLength, FSScratch *scratch);*/
+        search->classMI[i] = scratchColumnMI(set.features + i, &(set.classColumn), noOfSamples, scratch);
+    }
+
+    while ((search->noOfSelected < k) && (searchRound(search, &set, 1, scratch) == 0)) {
+        /*each round selects one more feature*/
+    }
+
+    copySelection(search, k, outputFeatures, featureScores);
+
+    return FS_OK;
+}/*workspaceFeatureSelection(uint,uint,uint,uint[][],uint[],FSCriterion*,uint[],double[],void*,size_t)*/
@@ -0,0 +1,976 @@
+/*******************************************************************************
+** FSShards.c
+** Implements sample sharded JMI and CMIM, where forked worker processes count
+** the contingency tables of their own rows and the calling process sums them.
+**
+** Author: Adam Pocock
+** Created: 17/10/2026
+**
+** Part of the FEAture Selection Toolbox (FEAST), please reference
+** "Conditional Likelihood Maximisation: A Unifying Framework for Information
+** Theoretic Feature Selection"
+** G. Brown, A. Pocock, M.-J. Zhao, M. Lujan
+** Journal of Machine Learning Research (JMLR), 2012
+**
+** Please check www.github.com/Craigacp/FEAST for updates.
+** 
+** Copyright (c) 2010-2017, A. Pocock, G. Brown, The University of Manchester
+** All rights reserved.
+** 
+** Redistribution and use in source and binary forms, with or without modification,
+** are permitted provided that the following conditions are met:
+** 
+**   - Redistributions of source code must retain the above copyright notice, this 
+**     list of conditions and the following disclaimer.
+**   - Redistributions in binary form must reproduce the above copyright notice, 
+**     this list of conditions and the following disclaimer in the documentation 
+**     and/or other materials provided with the distribution.
+**   - Neither the name of The University of Manchester nor the names of its 
+**     contributors may be used to endorse or promote products derived from this 
+**     software without specific prior written permission.
+** 
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+** ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+** ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES 
+** (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+** LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON 
+** ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+** SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+*******************************************************************************/
+
+
+/*fork, socketpair and MSG_NOSIGNAL need the POSIX definitions*/
+#define _POSIX_C_SOURCE 200809L
+
+#include "FEAST/FSShards.h"
+#include "FEAST/FSToolbox.h"
+#include "FSInternal.h"
+
+#ifndef _WIN32
+  #define FS_SHARDS
+  #include <errno.h>
+  #include <unistd.h>
+  #include <sys/types.h>
+  #include <sys/socket.h>
+  #include <sys/wait.h>
+#endif
+
+/* MIToolbox includes */
+#include "MIToolbox/ArrayOperations.h"
+
+/*******************************************************************************
+** Each request is FS_SHARD_HEADER_FIELDS uints, the command, the first
+** feature and the number of candidates, followed by the candidate indices.
+**
+** FS_SHARD_CLASS asks for the (feature,class) table of every feature in
+** index order, each numStates * classNumStates counts with cell (x,c) at
+** x + numStates*c.
+**
+** FS_SHARD_JOINT asks for the (first,candidate,class) table of each
+** candidate, as the number of pairs followed by each pair as its first
+** state, its candidate state and its classNumStates counts. The pairs are in
+** the order they first appear in the worker's rows.
+**
+** FS_SHARD_EXIT stops the worker.
+**
+** A feature sharded worker is sent requests with the same header. The second
+** field is the criterion for FS_SHARD_START, the selected feature for
+** FS_SHARD_SELECT and FS_SHARD_COLUMN, and the third is the round for
+** FS_SHARD_SELECT.
+**
+** FS_SHARD_START is followed by betaParam and gammaParam. It starts a new
+** search, and the worker replies with the score and index of its feature with
+** the highest class MI.
+**
+** FS_SHARD_SELECT is followed by the selected column as noOfSamples uints,
+** except for MIM which needs no terms. The worker adds the selected feature's
+** terms to its candidates, and replies with the score and index of its best
+** candidate, or of the criterion's starting value if it has none left.
+**
+** FS_SHARD_COLUMN asks the worker which owns a feature for its values.
+*******************************************************************************/
+#define FS_SHARD_CLASS 1
+#define FS_SHARD_JOINT 2
+#define FS_SHARD_EXIT 3
+#define FS_SHARD_START 4
+#define FS_SHARD_SELECT 5
+#define FS_SHARD_COLUMN 6
+#define FS_SHARD_HEADER_FIELDS 3
+
+/*******************************************************************************
+** The shards split the rows of set, or its features if byFeature is set.
+** Shard s holds rows or features shardStarts[s] up to shardStarts[s+1].
+*******************************************************************************/
+struct FEASTShards {
+    FSColumnSet set;
+    void *mapping;
+    size_t mappingSize;
+    int byFeature;
+    uint noOfShards;
+    uint *shardStarts;
+#ifdef FS_SHARDS
+    int *sockets;
+    pid_t *workers;
+#endif
+};
+
+#ifdef FS_SHARDS
+
+/*******************************************************************************
+** sendAll() and receiveAll() move length bytes over a socket, returning 0 on
+** success and -1 if the other end has gone.
+*******************************************************************************/
+static int sendAll(int socket, void *buffer, size_t length) {
+    char *position = (char *) buffer;
+    ssize_t sent;
+
+    while (length > 0) {
+        sent = send(socket, position, length, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        position += sent;
+        length -= sent;
+    }
+
+    return 0;
+}/*sendAll(int,void*,size_t)*/
+
+static int receiveAll(int socket, void *buffer, size_t length) {
+    char *position = (char *) buffer;
+    ssize_t received;
+
+    while (length > 0) {
+        received = recv(socket, position, length, 0);
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        } else if (received == 0) {
+            return -1;
+        }
+        position += received;
+        length -= received;
+    }
+
+    return 0;
+}/*receiveAll(int,void*,size_t)*/
+
+/*******************************************************************************
+** countJointTable() counts the (first,second,class) table of noOfRows rows
+** into table in the FS_SHARD_JOINT reply format, returning the number of
+** uints written. table must hold 1 + pairs * (2 + classNumStates) uints,
+** where pairs is the smaller of noOfRows and the number of possible pairs.
+*******************************************************************************/
+static size_t countJointTable(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn, int noOfRows, uint *table) {
+    int firstNumStates = firstColumn->numStates;
+    int classNumStates = classColumn->numStates;
+    int recordSize = 2 + classNumStates;
+    int *stateMap = (int *) checkedCalloc((size_t) firstNumStates * secondColumn->numStates,sizeof(int));
+    uint *record;
+    int numPairStates = 0;
+    int start, length, i;
+    int block[FS_BLOCK_SIZE];
+    int classBlock[FS_BLOCK_SIZE];
+
+    for (start = 0; start < noOfRows; start += FS_BLOCK_SIZE) {
+        length = noOfRows - start < FS_BLOCK_SIZE ? noOfRows - start : FS_BLOCK_SIZE;
+        loadColumnBlock(firstColumn,start,length,block);
+        addColumnBlock(secondColumn,start,length,firstNumStates,block);
+        loadColumnBlock(classColumn,start,length,classBlock);
+        for (i = 0; i < length; i++) {
+            if (stateMap[block[i]] == 0) {
+                record = table + 1 + numPairStates * recordSize;
+                record[0] = block[i] % firstNumStates;
+                record[1] = block[i] / firstNumStates;
+                numPairStates++;
+                stateMap[block[i]] = numPairStates;
+            }
+            table[1 + (stateMap[block[i]] - 1) * recordSize + 2 + classBlock[i]]++;
+        }
+    }
+
+    table[0] = numPairStates;
+
+    FREE_FUNC(stateMap);
+    stateMap = NULL;
+
+    return 1 + (size_t) numPairStates * recordSize;
+}/*countJointTable(FSColumn*,FSColumn*,FSColumn*,int,uint[])*/
+
+/*******************************************************************************
+** runWorker() answers requests for the noOfRows rows of set starting at
+** firstRow until it is told to stop or the coordinator goes away.
+*******************************************************************************/
+static void runWorker(FSColumnSet *set, uint firstRow, uint noOfRows, int socket) {
+    uint noOfFeatures = set->noOfFeatures;
+    uint classNumStates = set->classColumn.numStates;
+    FSColumn *features = (FSColumn *) checkedCalloc(noOfFeatures,sizeof(FSColumn));
+    FSColumn classColumn = set->classColumn;
+    uint header[FS_SHARD_HEADER_FIELDS];
+    uint *candidates, *table;
+    size_t tableSize, pairCapacity, used;
+    int start, length, failed = 0;
+    uint i, j;
+    int block[FS_BLOCK_SIZE];
+
+    /*the slice reads the worker's rows in place*/
+    for (i = 0; i < noOfFeatures; i++) {
+        features[i] = set->features[i];
+        features[i].data = ((char *) features[i].data) + (size_t) firstRow * features[i].width;
+        features[i].noOfEntries = noOfRows;
+    }
+    classColumn.data = ((char *) classColumn.data) + (size_t) firstRow * classColumn.width;
+    classColumn.noOfEntries = noOfRows;
+
+    while (!failed && (receiveAll(socket, header, sizeof(header)) == 0) && (header[0] != FS_SHARD_EXIT)) {
+        if (header[0] == FS_SHARD_CLASS) {
+            for (i = 0; (i < noOfFeatures) && !failed; i++) {
+                tableSize = (size_t) features[i].numStates * classNumStates;
+                table = (uint *) checkedCalloc(tableSize,sizeof(uint));
+                for (start = 0; start < (int) noOfRows; start += FS_BLOCK_SIZE) {
+                    length = (int) noOfRows - start < FS_BLOCK_SIZE ? (int) noOfRows - start : FS_BLOCK_SIZE;
+                    loadColumnBlock(features + i,start,length,block);
+                    addColumnBlock(&classColumn,start,length,features[i].numStates,block);
+                    for (j = 0; j < (uint) length; j++) {
+                        table[block[j]]++;
+                    }
+                }
+                failed = sendAll(socket, table, tableSize * sizeof(uint));
+                FREE_FUNC(table);
+                table = NULL;
+            }
+        } else if (header[0] == FS_SHARD_JOINT) {
+            candidates = (uint *) checkedCalloc(header[2] + 1,sizeof(uint));
+            failed = receiveAll(socket, candidates, header[2] * sizeof(uint));
+            for (i = 0; (i < header[2]) && !failed; i++) {
+                pairCapacity = (size_t) features[header[1]].numStates * features[candidates[i]].numStates;
+                pairCapacity = pairCapacity < noOfRows ? pairCapacity : noOfRows;
+                table = (uint *) checkedCalloc(1 + pairCapacity * (2 + classNumStates),sizeof(uint));
+                used = countJointTable(features + header[1], features + candidates[i], &classColumn, noOfRows, table);
+                failed = sendAll(socket, table, used * sizeof(uint));
+                FREE_FUNC(table);
+                table = NULL;
+            }
+            FREE_FUNC(candidates);
+            candidates = NULL;
+        } else {
+            failed = 1;
+        }
+    }
+
+    FREE_FUNC(features);
+    features = NULL;
+}/*runWorker(FSColumnSet*,uint,uint,int)*/
+
+/*******************************************************************************
+** sendBest() replies with a score and a feature index.
+*******************************************************************************/
+static int sendBest(int socket, double score, int index) {
+    if ((sendAll(socket, &score, sizeof(double)) != 0) || (sendAll(socket, &index, sizeof(int)) != 0)) {
+        return -1;
+    }
+    return 0;
+}/*sendBest(int,double,int)*/
+
+/*******************************************************************************
+** runFeatureWorker() answers requests for the noOfOwned features of set
+** starting at firstFeature, keeping the running score of each of them, until
+** it is told to stop or the coordinator goes away. The class is read in full,
+** and the selected column is only held while its terms are added.
+**
+** The scores are updated as in the column algorithms, so each candidate's
+** score, and hence the selection, is identical.
+*******************************************************************************/
+static void runFeatureWorker(FSColumnSet *set, uint firstFeature, uint noOfOwned, int socket) {
+    uint noOfSamples = set->noOfSamples;
+    FSColumn *features = set->features + firstFeature;
+    FSColumn *classColumn = &(set->classColumn);
+    char *selectedFeatures = (char *) checkedCalloc(noOfOwned + 1,sizeof(char));
+    double *classMI = (double *) checkedCalloc(noOfOwned + 1,sizeof(double));
+    /*the running score of each candidate, or its sum of redundancy terms for mRMR_D and BetaGamma*/
+    double *runningScores = (double *) checkedCalloc(noOfOwned + 1,sizeof(double));
+    uint *selectedVector = (uint *) checkedCalloc(noOfSamples + 1,sizeof(uint));
+    uint *conditionVector = NULL;
+    FSColumn selectedColumn, conditionColumn;
+    uint header[FS_SHARD_HEADER_FIELDS];
+    double parameters[2];
+    FSCriterion criterion;
+    double score, currentScore, term = 0.0;
+    int currentHighestFeature;
+    JointStatistics stats;
+    uint selected, round, j;
+    int failed = 0;
+
+    selectedColumn.data = selectedVector;
+    selectedColumn.width = sizeof(uint);
+    selectedColumn.bits = NULL;
+    selectedColumn.rowIndices = NULL;
+    selectedColumn.noOfEntries = noOfSamples;
+    selectedColumn.stateCounts = NULL;
+    selectedColumn.rowCounts = NULL;
+    conditionColumn = selectedColumn;
+    criterion.criterion = FS_JMI;
+    criterion.betaParam = 0.0;
+    criterion.gammaParam = 0.0;
+
+    while (!failed && (receiveAll(socket, header, sizeof(header)) == 0) && (header[0] != FS_SHARD_EXIT)) {
+        if (header[0] == FS_SHARD_START) {
+            failed = receiveAll(socket, parameters, sizeof(parameters));
+            criterion.criterion = header[1];
+            if (conditionVector != NULL) {
+                FREE_FUNC(conditionVector);
+                conditionVector = NULL;
+            }
+            criterion.betaParam = parameters[0];
+            criterion.gammaParam = parameters[1];
+
+            score = -1.0;
+            currentHighestFeature = -1;
+            for (j = 0; j < noOfOwned; j++) {
+                /*double calcColumnMI(FSColumn *firstColumn, FSColumn *secondColumn, int vectorLength);*/
+                classMI[j] = calcColumnMI(features + j, classColumn, noOfSamples);
+                selectedFeatures[j] = 0;
+                runningScores[j] = startingRunningScore(criterion.criterion, classMI[j]);
+                if (classMI[j] > score) {
+                    score = classMI[j];
+                    currentHighestFeature = firstFeature + j;
+                }
+            }
+
+            if (!failed) {
+                failed = sendBest(socket, score, currentHighestFeature);
+            }
+        } else if (header[0] == FS_SHARD_SELECT) {
+            selected = header[1];
+            round = header[2];
+            if ((selected >= firstFeature) && (selected < firstFeature + noOfOwned)) {
+                selectedFeatures[selected - firstFeature] = 1;
+            }
+
+            if (criterion.criterion != FS_MIM) {
+                failed = receiveAll(socket, selectedVector, noOfSamples * sizeof(uint));
+                selectedColumn.numStates = set->features[selected].numStates;
+            }
+
+            if (criterion.criterion == FS_CONDMI) {
+                /*the condition is the joint state of every selected feature*/
+                if (conditionVector == NULL) {
+                    conditionVector = (uint *) checkedCalloc(noOfSamples + 1,sizeof(uint));
+                    memcpy(conditionVector, selectedVector, noOfSamples * sizeof(uint));
+                    conditionColumn.numStates = selectedColumn.numStates;
+                } else {
+                    mergeArrays(selectedVector, conditionVector, conditionVector, noOfSamples);
+                    conditionColumn.numStates = maxState(conditionVector, noOfSamples);
+                }
+                conditionColumn.data = conditionVector;
+            }
+
+            startingCandidate(criterion.criterion, &score, &currentHighestFeature);
+            for (j = 0; (j < noOfOwned) && !failed; j++) {
+                if (selectedFeatures[j]) {
+                    continue;
+                }
+                if (criterion.criterion == FS_MRMR_D) {
+                    /*double calcColumnMI(FSColumn *firstColumn, FSColumn *secondColumn, int vectorLength);*/
+                    term = calcColumnMI(&selectedColumn, features + j, noOfSamples);
+                } else if (criterion.criterion != FS_MIM) {
+                    /*JointStatistics calcJointStatistics(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn, int vectorLength);*/
+                    stats = calcJointStatistics(criterion.criterion == FS_CONDMI ? &conditionColumn : &selectedColumn, features + j, classColumn, noOfSamples);
+                    term = criterionTerm(&criterion, &stats);
+                }
+                currentScore = scoreCandidate(&criterion, term, classMI[j], round, runningScores + j);
+                if (BETTER_CANDIDATE(currentScore,(int) (firstFeature + j),score,currentHighestFeature)) {
+                    score = currentScore;
+                    currentHighestFeature = firstFeature + j;
+                }
+            }
+
+            if (!failed) {
+                failed = sendBest(socket, score, currentHighestFeature);
+            }
+        } else if ((header[0] == FS_SHARD_COLUMN) && (header[1] >= firstFeature) && (header[1] < firstFeature + noOfOwned)) {
+            unpackColumn(set->features + header[1], noOfSamples, selectedVector);
+            failed = sendAll(socket, selectedVector, noOfSamples * sizeof(uint));
+        } else {
+            failed = 1;
+        }
+
+    }
+
+    FREE_FUNC(selectedFeatures);
+    FREE_FUNC(classMI);
+    FREE_FUNC(runningScores);
+    FREE_FUNC(selectedVector);
+    if (conditionVector != NULL) {
+        FREE_FUNC(conditionVector);
+    }
+
+    selectedFeatures = NULL;
+    classMI = NULL;
+    runningScores = NULL;
+    selectedVector = NULL;
+    conditionVector = NULL;
+}/*runFeatureWorker(FSColumnSet*,uint,uint,int)*/
+
+/*******************************************************************************
+** startWorkers() forks one worker for each shard, splitting the rows, or the
+** features, into noOfShards contiguous blocks whose sizes differ by at most
+** one. Returns 0 on success, and -1 if a worker can't be started.
+*******************************************************************************/
+static int startWorkers(FEASTShards *shards) {
+    uint noOfItems = shards->byFeature ? shards->set.noOfFeatures : shards->set.noOfSamples;
+    uint baseItems = noOfItems / shards->noOfShards;
+    uint extraItems = noOfItems % shards->noOfShards;
+    uint first, length;
+    int pair[2];
+    uint s, t;
+
+    shards->shardStarts = (uint *) checkedCalloc(shards->noOfShards + 1,sizeof(uint));
+    shards->sockets = (int *) checkedCalloc(shards->noOfShards,sizeof(int));
+    shards->workers = (pid_t *) checkedCalloc(shards->noOfShards,sizeof(pid_t));
+
+    for (s = 0; s < shards->noOfShards; s++) {
+        shards->shardStarts[s + 1] = shards->shardStarts[s] + baseItems + (s < extraItems ? 1 : 0);
+        shards->sockets[s] = -1;
+    }
+
+    /*make sure buffered output isn't written again by the workers*/
+    fflush(NULL);
+
+    for (s = 0; s < shards->noOfShards; s++) {
+        first = shards->shardStarts[s];
+        length = shards->shardStarts[s + 1] - first;
+
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) {
+            return -1;
+        }
+
+        shards->workers[s] = fork();
+        if (shards->workers[s] < 0) {
+            close(pair[0]);
+            close(pair[1]);
+            return -1;
+        } else if (shards->workers[s] == 0) {
+            /*the worker keeps only its own end of its own socket*/
+            for (t = 0; t < s; t++) {
+                close(shards->sockets[t]);
+            }
+            close(pair[0]);
+            if (shards->byFeature) {
+                runFeatureWorker(&(shards->set), first, length, pair[1]);
+            } else {
+                runWorker(&(shards->set), first, length, pair[1]);
+            }
+            close(pair[1]);
+            _exit(0);
+        }
+
+        close(pair[1]);
+        shards->sockets[s] = pair[0];
+    }
+
+    return 0;
+}/*startWorkers(FEASTShards*)*/
+
+/*******************************************************************************
+** sendRequest() sends a request to every worker, returning 0 on success.
+*******************************************************************************/
+static int sendRequest(FEASTShards *shards, uint command, uint first, uint noOfCandidates, uint *candidates) {
+    uint header[FS_SHARD_HEADER_FIELDS];
+    uint s;
+
+    header[0] = command;
+    header[1] = first;
+    header[2] = noOfCandidates;
+
+    for (s = 0; s < shards->noOfShards; s++) {
+        if ((sendAll(shards->sockets[s], header, sizeof(header)) != 0)
+            || ((noOfCandidates > 0) && (sendAll(shards->sockets[s], candidates, noOfCandidates * sizeof(uint)) != 0))) {
+            return -1;
+        }
+    }
+
+    return 0;
+}/*sendRequest(FEASTShards*,uint,uint,uint,uint[])*/
+
+/*******************************************************************************
+** requestClassMI() fills classMI with I(X_i;Y) for each feature i, summing
+** the workers' tables. Returns 0 on success.
+*******************************************************************************/
+static int requestClassMI(FEASTShards *shards, double *classMI) {
+    FSColumnSet *set = &(shards->set);
+    int classNumStates = set->classColumn.numStates;
+    int *jointCounts;
+    uint *table;
+    size_t tableSize, j;
+    uint i, s;
+    int failed = sendRequest(shards, FS_SHARD_CLASS, 0, 0, NULL);
+
+    for (i = 0; (i < set->noOfFeatures) && !failed; i++) {
+        tableSize = (size_t) set->features[i].numStates * classNumStates;
+        /*double calcTableMI(int *jointCounts, int firstNumStates, int secondNumStates, double totalLength);*/
+        jointCounts = (int *) checkedCalloc(tableSize + set->features[i].numStates + classNumStates,sizeof(int));
+        table = (uint *) checkedCalloc(tableSize,sizeof(uint));
+        for (s = 0; (s < shards->noOfShards) && !failed; s++) {
+            failed = receiveAll(shards->sockets[s], table, tableSize * sizeof(uint));
+            for (j = 0; (j < tableSize) && !failed; j++) {
+                jointCounts[j] += table[j];
+            }
+        }
+        if (!failed) {
+            classMI[i] = calcTableMI(jointCounts, set->features[i].numStates, classNumStates, set->noOfSamples);
+        }
+        FREE_FUNC(jointCounts);
+        FREE_FUNC(table);
+        jointCounts = NULL;
+        table = NULL;
+    }
+
+    return failed ? -1 : 0;
+}/*requestClassMI(FEASTShards*,double[])*/
+
+/*******************************************************************************
+** requestJointStatistics() fills stats[i] with the JointStatistics of
+** (first,candidates[i],class), merging the workers' tables in shard order so
+** the pairs are numbered in the order they first appear in the dataset, as
+** in calcJointStatistics(). Returns 0 on success.
+*******************************************************************************/
+static int requestJointStatistics(FEASTShards *shards, uint first, uint noOfCandidates, uint *candidates, JointStatistics *stats) {
+    FSColumnSet *set = &(shards->set);
+    int firstNumStates = set->features[first].numStates;
+    int secondNumStates;
+    int classNumStates = set->classColumn.numStates;
+    int recordSize = 2 + classNumStates;
+    uint **tables = (uint **) checkedCalloc(shards->noOfShards,sizeof(uint *));
+    uint *shardPairs = (uint *) checkedCalloc(shards->noOfShards,sizeof(uint));
+    int *stateMap, *jointCounts, *pairCounts;
+    uint *pairFirst, *pairSecond, *record;
+    size_t totalPairs;
+    int numPairStates, pairState, c;
+    uint i, s, p;
+    int failed = sendRequest(shards, FS_SHARD_JOINT, first, noOfCandidates, candidates);
+
+    for (i = 0; (i < noOfCandidates) && !failed; i++) {
+        secondNumStates = set->features[candidates[i]].numStates;
+
+        /*the replies for one candidate are read from every worker in turn*/
+        totalPairs = 0;
+        for (s = 0; (s < shards->noOfShards) && !failed; s++) {
+            failed = receiveAll(shards->sockets[s], shardPairs + s, sizeof(uint));
+            if (!failed) {
+                tables[s] = (uint *) checkedCalloc((size_t) shardPairs[s] * recordSize + 1,sizeof(uint));
+                failed = receiveAll(shards->sockets[s], tables[s], (size_t) shardPairs[s] * recordSize * sizeof(uint));
+                totalPairs += shardPairs[s];
+            }
+        }
+
+        if (!failed) {
+            stateMap = (int *) checkedCalloc((size_t) firstNumStates * secondNumStates,sizeof(int));
+            pairFirst = (uint *) checkedCalloc(2 * totalPairs + 1,sizeof(uint));
+            pairSecond = pairFirst + totalPairs;
+            pairCounts = (int *) checkedCalloc(totalPairs * classNumStates + 1,sizeof(int));
+            numPairStates = 0;
+
+            for (s = 0; s < shards->noOfShards; s++) {
+                for (p = 0; p < shardPairs[s]; p++) {
+                    record = tables[s] + (size_t) p * recordSize;
+                    pairState = record[0] + firstNumStates * record[1];
+                    if (stateMap[pairState] == 0) {
+                        pairFirst[numPairStates] = record[0];
+                        pairSecond[numPairStates] = record[1];
+                        numPairStates++;
+                        stateMap[pairState] = numPairStates;
+                    }
+                    for (c = 0; c < classNumStates; c++) {
+                        pairCounts[(stateMap[pairState] - 1) * classNumStates + c] += record[2 + c];
+                    }
+                }
+            }
+
+            jointCounts = (int *) checkedCalloc(numPairStates * classNumStates,sizeof(int));
+            for (pairState = 0; pairState < numPairStates; pairState++) {
+                for (c = 0; c < classNumStates; c++) {
+                    jointCounts[pairState + numPairStates * c] = pairCounts[pairState * classNumStates + c];
+                }
+            }
+
+            stats[i] = calcTableStatistics(jointCounts,numPairStates,pairFirst,pairSecond,firstNumStates,secondNumStates,classNumStates,set->noOfSamples);
+
+            FREE_FUNC(stateMap);
+            FREE_FUNC(pairFirst);
+            FREE_FUNC(pairCounts);
+            FREE_FUNC(jointCounts);
+            stateMap = NULL;
+            pairFirst = NULL;
+            pairCounts = NULL;
+            jointCounts = NULL;
+        }
+
+        for (s = 0; s < shards->noOfShards; s++) {
+            if (tables[s] != NULL) {
+                FREE_FUNC(tables[s]);
+                tables[s] = NULL;
+            }
+        }
+    }
+
+    FREE_FUNC(tables);
+    FREE_FUNC(shardPairs);
+    tables = NULL;
+    shardPairs = NULL;
+
+    return failed ? -1 : 0;
+}/*requestJointStatistics(FEASTShards*,uint,uint,uint[],JointStatistics[])*/
+
+/*******************************************************************************
+** rowShardedSearch() runs JMI or CMIM over row shards, summing the workers'
+** count tables for each candidate.
+*******************************************************************************/
+static uint* rowShardedSearch(uint k, FEASTShards *shards, FSCriterion *criterion, uint *outputFeatures, double *featureScores) {
+    uint noOfFeatures = shards->set.noOfFeatures;
+    char *selectedFeatures = (char *) checkedCalloc(noOfFeatures,sizeof(char));
+    double *classMI = (double *) checkedCalloc(noOfFeatures,sizeof(double));
+    /*the running sum of JMI's terms, or CMIM's partial score, the minimum conditional MI so far*/
+    double *runningScores = (double *) checkedCalloc(noOfFeatures,sizeof(double));
+    uint *candidates = (uint *) checkedCalloc(noOfFeatures,sizeof(uint));
+    JointStatistics *stats = (JointStatistics *) checkedCalloc(noOfFeatures,sizeof(JointStatistics));
+
+    double maxMI = -1.0;
+    int maxMICounter = -1;
+
+    double score, currentScore;
+    int currentHighestFeature;
+    uint noOfCandidates;
+    int failed;
+
+    uint i, j;
+
+    failed = requestClassMI(shards, classMI);
+
+    for (i = 0; (i < noOfFeatures) && !failed; i++) {
+        runningScores[i] = startingRunningScore(criterion->criterion, classMI[i]);
+        if (classMI[i] > maxMI) {
+            maxMI = classMI[i];
+            maxMICounter = i;
+        }/*if bigger than current maximum*/
+    }/*for noOfFeatures - filling classMI*/
+
+    if (!failed) {
+        selectedFeatures[maxMICounter] = 1;
+        outputFeatures[0] = maxMICounter;
+        featureScores[0] = maxMI;
+    }
+
+    for (i = 1; (i < k) && !failed; i++) {
+        startingCandidate(criterion->criterion, &score, &currentHighestFeature);
+
+        noOfCandidates = 0;
+        for (j = 0; j < noOfFeatures; j++) {
+            if (!selectedFeatures[j]) {
+                candidates[noOfCandidates] = j;
+                noOfCandidates++;
+            }
+        }
+
+        /*only the term for the last selected feature is new*/
+        failed = requestJointStatistics(shards, outputFeatures[i-1], noOfCandidates, candidates, stats);
+
+        for (j = 0; (j < noOfCandidates) && !failed; j++) {
+            /*double scoreCandidate(FSCriterion *criterion, double term, double classMI, uint round, double *runningScore);*/
+            currentScore = scoreCandidate(criterion, criterionTerm(criterion, stats + j), classMI[candidates[j]], i, runningScores + candidates[j]);
+            if (BETTER_CANDIDATE(currentScore,(int) candidates[j],score,currentHighestFeature)) {
+                score = currentScore;
+                currentHighestFeature = candidates[j];
+            }
+        }
+
+        selectedFeatures[currentHighestFeature] = 1;
+        outputFeatures[i] = currentHighestFeature;
+        featureScores[i] = score;
+    }/*for the number of features to select*/
+
+    FREE_FUNC(selectedFeatures);
+    FREE_FUNC(classMI);
+    FREE_FUNC(runningScores);
+    FREE_FUNC(candidates);
+    FREE_FUNC(stats);
+
+    selectedFeatures = NULL;
+    classMI = NULL;
+    runningScores = NULL;
+    candidates = NULL;
+    stats = NULL;
+
+    return failed ? NULL : outputFeatures;
+}/*rowShardedSearch(uint,FEASTShards*,FSCriterion*,uint[],double[])*/
+
+/*******************************************************************************
+** receiveBest() reads each worker's best (score,index) in shard order and
+** reduces them with BETTER_CANDIDATE, starting from startingCandidate().
+** Returns 0 on success.
+*******************************************************************************/
+static int receiveBest(FEASTShards *shards, int criterion, double *score, int *index) {
+    double shardScore;
+    int shardIndex;
+    uint s;
+
+    startingCandidate(criterion, score, index);
+
+    for (s = 0; s < shards->noOfShards; s++) {
+        if ((receiveAll(shards->sockets[s], &shardScore, sizeof(double)) != 0)
+            || (receiveAll(shards->sockets[s], &shardIndex, sizeof(int)) != 0)) {
+            return -1;
+        }
+        if ((shardIndex >= 0) && BETTER_CANDIDATE(shardScore,shardIndex,*score,*index)) {
+            *score = shardScore;
+            *index = shardIndex;
+        }
+    }
+
+    return 0;
+}/*receiveBest(FEASTShards*,int,double*,int*)*/
+
+/*******************************************************************************
+** featureShardedSearch() runs a forward search over feature shards. Each
+** round the selected column is fetched from the worker which owns it and
+** sent to every worker, which scores its own candidates against it and
+** replies with its best. Only one column is ever held by the coordinator.
+*******************************************************************************/
+static uint* featureShardedSearch(uint k, FEASTShards *shards, FSCriterion *criterion, uint *outputFeatures, double *featureScores) {
+    uint noOfSamples = shards->set.noOfSamples;
+    uint *selectedVector = NULL;
+    uint header[FS_SHARD_HEADER_FIELDS];
+    double parameters[2];
+    double score;
+    int currentHighestFeature;
+    int failed = 0;
+    uint owner, i, s;
+
+    header[0] = FS_SHARD_START;
+    header[1] = criterion->criterion;
+    header[2] = 0;
+    parameters[0] = criterion->betaParam;
+    parameters[1] = criterion->gammaParam;
+
+    for (s = 0; (s < shards->noOfShards) && !failed; s++) {
+        failed = (sendAll(shards->sockets[s], header, sizeof(header)) != 0)
+              || (sendAll(shards->sockets[s], parameters, sizeof(parameters)) != 0);
+    }
+
+    /*the first feature is the one with the highest class MI, for every criterion*/
+    if (!failed) {
+        failed = receiveBest(shards, FS_MIM, &score, &currentHighestFeature);
+    }
+    if (!failed) {
+        outputFeatures[0] = currentHighestFeature;
+        featureScores[0] = score;
+    }
+
+    if (criterion->criterion != FS_MIM) {
+        selectedVector = (uint *) checkedCalloc(noOfSamples + 1,sizeof(uint));
+    }
+
+    for (i = 1; (i < k) && !failed; i++) {
+        if (selectedVector != NULL) {
+            for (owner = 0; shards->shardStarts[owner + 1] <= outputFeatures[i-1]; owner++) {
+            }
+            header[0] = FS_SHARD_COLUMN;
+            header[1] = outputFeatures[i-1];
+            header[2] = 0;
+            failed = (sendAll(shards->sockets[owner], header, sizeof(header)) != 0)
+                  || (receiveAll(shards->sockets[owner], selectedVector, noOfSamples * sizeof(uint)) != 0);
+        }
+
+        header[0] = FS_SHARD_SELECT;
+        header[1] = outputFeatures[i-1];
+        header[2] = i;
+        for (s = 0; (s < shards->noOfShards) && !failed; s++) {
+            failed = (sendAll(shards->sockets[s], header, sizeof(header)) != 0)
+                  || ((selectedVector != NULL) && (sendAll(shards->sockets[s], selectedVector, noOfSamples * sizeof(uint)) != 0));
+        }
+
+        if (!failed) {
+            failed = receiveBest(shards, criterion->criterion, &score, &currentHighestFeature);
+        }
+
+        if (!failed && (currentHighestFeature == -1)) {
+            /*CondMI has run out of informative features, and would select nothing from here on*/
+            for (; i < k; i++) {
+                outputFeatures[i] = (uint) -1;
+                featureScores[i] = 0.0;
+            }
+        } else if (!failed) {
+            outputFeatures[i] = currentHighestFeature;
+            featureScores[i] = score;
+        }
+    }/*for the number of features to select*/
+
+    if (selectedVector != NULL) {
+        FREE_FUNC(selectedVector);
+        selectedVector = NULL;
+    }
+
+    return failed ? NULL : outputFeatures;
+}/*featureShardedSearch(uint,FEASTShards*,FSCriterion*,uint[],double[])*/
+
+/*******************************************************************************
+** createShards() starts the workers over a column set the shards now own,
+** freeing everything if they can't be started.
+*******************************************************************************/
+static FEASTShards* createShards(FEASTShards *shards, uint noOfShards, int byFeature) {
+    uint noOfItems = byFeature ? shards->set.noOfFeatures : shards->set.noOfSamples;
+
+    shards->byFeature = byFeature;
+    shards->noOfShards = noOfShards < 1 ? 1 : noOfShards;
+    if ((noOfItems > 0) && (shards->noOfShards > noOfItems)) {
+        shards->noOfShards = noOfItems;
+    }
+
+    if (startWorkers(shards) != 0) {
+        freeFEASTShards(shards);
+        shards = NULL;
+    }
+
+    return shards;
+}/*createShards(FEASTShards*,uint,int)*/
+
+/*******************************************************************************
+** mapShards() and copyShards() build the column set of a column file or of
+** an in memory dataset, which the workers then read in place.
+*******************************************************************************/
+static FEASTShards* mapShards(const char *fileName, uint noOfShards, int byFeature) {
+    FEASTShards *shards = (FEASTShards *) checkedCalloc(1,sizeof(FEASTShards));
+
+    if (mapColumnFile(fileName, &(shards->set), &(shards->mapping), &(shards->mappingSize)) != 0) {
+        FREE_FUNC(shards);
+        return NULL;
+    }
+
+    return createShards(shards, noOfShards, byFeature);
+}/*mapShards(const char*,uint,int)*/
+
+static FEASTShards* copyShards(uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint noOfShards, int byFeature) {
+    FEASTShards *shards = (FEASTShards *) checkedCalloc(1,sizeof(FEASTShards));
+
+    /*the columns are read in place, so the workers share the caller's arrays*/
+    createColumnSet(noOfSamples, noOfFeatures, featureMatrix, classColumn, NULL, &(shards->set));
+    shards->mapping = NULL;
+
+    return createShards(shards, noOfShards, byFeature);
+}/*copyShards(uint,uint,uint[][],uint[],uint,int)*/
+
+#endif
+
+FEASTShards* shardFEASTFile(const char *fileName, uint noOfShards) {
+#ifdef FS_SHARDS
+    return mapShards(fileName, noOfShards, 0);
+#else
+    return NULL;
+#endif
+}/*shardFEASTFile(const char*,uint)*/
+
+FEASTShards* shardFEASTData(uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint noOfShards) {
+#ifdef FS_SHARDS
+    return copyShards(noOfSamples, noOfFeatures, featureMatrix, classColumn, noOfShards, 0);
+#else
+    return NULL;
+#endif
+}/*shardFEASTData(uint,uint,uint[][],uint[],uint)*/
+
+FEASTShards* featureShardFEASTFile(const char *fileName, uint noOfShards) {
+#ifdef FS_SHARDS
+    return mapShards(fileName, noOfShards, 1);
+#else
+    return NULL;
+#endif
+}/*featureShardFEASTFile(const char*,uint)*/
+
+FEASTShards* featureShardFEASTData(uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint noOfShards) {
+#ifdef FS_SHARDS
+    return copyShards(noOfSamples, noOfFeatures, featureMatrix, classColumn, noOfShards, 1);
+#else
+    return NULL;
+#endif
+}/*featureShardFEASTData(uint,uint,uint[][],uint[],uint)*/
+
+void freeFEASTShards(FEASTShards *shards) {
+#ifdef FS_SHARDS
+    uint header[FS_SHARD_HEADER_FIELDS];
+    uint s;
+
+    if (shards == NULL) {
+        return;
+    }
+
+    header[0] = FS_SHARD_EXIT;
+    header[1] = 0;
+    header[2] = 0;
+
+    for (s = 0; s < shards->noOfShards; s++) {
+        if (shards->sockets[s] >= 0) {
+            sendAll(shards->sockets[s], header, sizeof(header));
+            close(shards->sockets[s]);
+        }
+    }
+
+    /*a worker still answering a failed request stops when its socket closes*/
+    for (s = 0; s < shards->noOfShards; s++) {
+        if (shards->workers[s] > 0) {
+            while ((waitpid(shards->workers[s], NULL, 0) < 0) && (errno == EINTR)) {
+            }
+        }
+    }
+
+    freeColumnSet(&(shards->set));
+    if (shards->mapping != NULL) {
+        unmapColumnFile(shards->mapping, shards->mappingSize);
+        shards->mapping = NULL;
+    }
+
+    FREE_FUNC(shards->shardStarts);
+    FREE_FUNC(shards->sockets);
+    FREE_FUNC(shards->workers);
+    FREE_FUNC(shards);
+    shards = NULL;
+#endif
+}/*freeFEASTShards(FEASTShards*)*/
+
+uint* shardedSearch(uint k, FEASTShards *shards, FSCriterion *criterion, uint *outputFeatures, double *featureScores) {
+#ifdef FS_SHARDS
+    if (shards->byFeature) {
+        return featureShardedSearch(k, shards, criterion, outputFeatures, featureScores);
+    } else if ((criterion->criterion == FS_JMI) || (criterion->criterion == FS_CMIM)) {
+        return rowShardedSearch(k, shards, criterion, outputFeatures, featureScores);
+    }
+#endif
+    return NULL;
+}/*shardedSearch(uint,FEASTShards*,FSCriterion*,uint[],double[])*/
+
+uint* shardedJMI(uint k, FEASTShards *shards, uint *outputFeatures, double *featureScores) {
+    FSCriterion criterion;
+
+    criterion.criterion = FS_JMI;
+    criterion.betaParam = 0.0;
+    criterion.gammaParam = 0.0;
+
+    return shardedSearch(k, shards, &criterion, outputFeatures, featureScores);
+}/*shardedJMI(uint,FEASTShards*,uint[],double[])*/
+
+uint* shardedCMIM(uint k, FEASTShards *shards, uint *outputFeatures, double *featureScores) {
+    FSCriterion criterion;
+
+    criterion.criterion = FS_CMIM;
+    criterion.betaParam = 0.0;
+    criterion.gammaParam = 0.0;
+
+    return shardedSearch(k, shards, &criterion, outputFeatures, featureScores);
+}/*shardedCMIM(uint,FEASTShards*,uint[],double[])*/
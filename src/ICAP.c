@@ -10,6 +10,13 @@
 **           22/02/2014 - Patched calloc.
 **           12/03/2016 - Changed initial value of maxMI to -1.0 to prevent segfaults when I(X;Y) = 0.0 for all X.
 **           17/12/2016 - Added feature scores.
+**           17/10/2026 - Added multi-threaded candidate scoring.
+**           17/10/2026 - Moved the class MI calculation into the shared parallel relevance pass.
+**           17/10/2026 - Replaced the k*noOfFeatures MI cache with a running score per feature.
+**           17/10/2026 - Switched the pairwise terms to the fused joint statistics kernel.
+**           17/10/2026 - Split out a column variant which reads compact 8/16 bit columns.
+**           17/10/2026 - Added the FEASTDataset entry point.
+**           17/10/2026 - Added lazy evaluation, pruning candidates whose running score is below the best.
 **
 ** Author - Adam Pocock
 ** 
@@ -51,40 +58,50 @@
 
 #include "FEAST/FSAlgorithms.h"
 #include "FEAST/FSToolbox.h"
+#include "FSInternal.h"
+
+/* for memcpy */
+#include <string.h>
 
 /* MIToolbox includes */
 #include "MIToolbox/ArrayOperations.h"
 #include "MIToolbox/MutualInformation.h"
 
-uint* ICAP(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores) {
+uint* columnICAP(uint k, FSColumnSet *set, uint *outputFeatures, double *featureScores, FSOptions *options) {
+    uint noOfSamples = set->noOfSamples;
+    uint noOfFeatures = set->noOfFeatures;
     char *selectedFeatures = (char *) checkedCalloc(noOfFeatures,sizeof(char));
 
     /*holds the class MI values*/
     double *classMI = (double *) checkedCalloc(noOfFeatures,sizeof(double));
 
-    /*holds the intra feature MI values*/
-    int sizeOfMatrix = k*noOfFeatures;
-    double *featureInteractionMatrix = (double *) checkedCalloc(sizeOfMatrix,sizeof(double));
+    /*holds the ICAP score of each feature, which gains one term per iteration*/
+    double *runningScores = (double *) checkedCalloc(noOfFeatures,sizeof(double));
 
     /*Changed to ensure it always picks a feature*/
     double maxMI = -1.0;
     int maxMICounter = -1;
 
-    double score, currentScore, mi, cmi;
-    int currentHighestFeature, arrayPosition;
+    double score;
+    int currentHighestFeature;
 
-    int i, j, m;
+    int numThreads = numberOfThreads(options);
 
-    for (i = 0; i < sizeOfMatrix; i++) {
-        featureInteractionMatrix[i] = -1;
-    }/*for featureInteractionMatrix - blank to -1*/
+    /*lazy evaluation only calculates the terms a candidate needs to beat the best score*/
+    int lazy = (options != NULL) && options->lazyEvaluation;
+    /*the number of selected features whose terms are in each running score*/
+    uint *lastUsedFeature = NULL;
+    /*the candidates in descending order of class MI*/
+    int *candidateOrder = NULL;
+
+    int i;
 
     /*SETUP COMPLETE*/
     /*Algorithm starts here*/
 
-    for (i = 0; i < noOfFeatures; i++) {
-        classMI[i] = calcMutualInformation(featureMatrix[i], classColumn, noOfSamples);
+    calculateClassMI(set, classMI, options);
 
+    for (i = 0; i < noOfFeatures; i++) {
         if (classMI[i] > maxMI) {
             maxMI = classMI[i];
             maxMICounter = i;
@@ -95,6 +112,14 @@ uint* ICAP(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, ui
     outputFeatures[0] = maxMICounter;
     featureScores[0] = maxMI;
 
+    if (lazy) {
+        lastUsedFeature = (uint *) checkedCalloc(noOfFeatures,sizeof(uint));
+        candidateOrder = rankByScore(classMI, noOfFeatures);
+    }
+
+    /*each score starts at the class MI, and only the negative interactions are added*/
+    memcpy(runningScores, classMI, sizeof(double)*noOfFeatures);
+
     /*************
      ** Now we have populated the classMI array, and selected the highest
      ** MI feature as the first output feature
@@ -108,37 +133,94 @@ uint* ICAP(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, ui
          **********************************************************************/
         score = -DBL_MAX;
         currentHighestFeature = 0;
-        currentScore = 0.0;
-
-        for (j = 0; j < noOfFeatures; j++) {
-            /*if we haven't selected j*/
-            if (!selectedFeatures[j]) {
-                currentScore = classMI[j];
-
-                for (m = 0; m < i; m++) {
-                    arrayPosition = m * noOfFeatures + j;
-
-                    if (featureInteractionMatrix[arrayPosition] == -1) {
-                        /*work out interaction*/
 
-                        /*double calcMutualInformation(uint *firstVector, uint *secondVector, int vectorLength);*/
-                        mi = calcMutualInformation(featureMatrix[outputFeatures[m]], featureMatrix[j], noOfSamples);
-                        /*double calcConditionalMutualInformation(uint *firstVector, uint *targetVector, uint *conditionVector, int vectorLength);*/
-                        cmi = calcConditionalMutualInformation(featureMatrix[outputFeatures[m]], featureMatrix[j], classColumn, noOfSamples);
-                        featureInteractionMatrix[arrayPosition] = cmi - mi;
-                    }/*if not already known*/
-
-                    if (featureInteractionMatrix[arrayPosition] < 0) {
-                        currentScore += featureInteractionMatrix[arrayPosition];
+        if (lazy) {
+            #pragma omp parallel num_threads(numThreads) if (numThreads > 1)
+            {
+                JointStatistics stats;
+                double currentScore, interaction, bound;
+                int j, o;
+
+                #pragma omp for schedule(dynamic,FS_CHUNK_SIZE)
+                for (o = 0; o < noOfFeatures; o++) {
+                    j = candidateOrder[o];
+                    /*if we haven't selected j*/
+                    if (!selectedFeatures[j]) {
+                        /*score is the best exact score found so far, so it only grows*/
+                        #pragma omp atomic read
+                        bound = score;
+
+                        currentScore = runningScores[j];
+
+                        /*only negative interactions are added, so the running score bounds the final score*/
+                        while ((currentScore >= bound) && (lastUsedFeature[j] < i)) {
+                            /*JointStatistics calcJointStatistics(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn, int vectorLength);*/
+                            stats = calcJointStatistics(set->features + outputFeatures[lastUsedFeature[j]], set->features + j, &(set->classColumn), noOfSamples);
+                            interaction = stats.cmi - stats.mi;
+
+                            if (interaction < 0) {
+                                runningScores[j] += interaction;
+                            }
+
+                            lastUsedFeature[j] += 1;
+                            currentScore = runningScores[j];
+
+                            #pragma omp atomic read
+                            bound = score;
+                        }/*while the bound may still win & terms are missing*/
+
+                        if ((lastUsedFeature[j] == i) && (currentScore >= bound)) {
+                            #pragma omp critical (ICAPScore)
+                            {
+                                if (BETTER_CANDIDATE(currentScore,j,score,currentHighestFeature)) {
+                                    #pragma omp atomic write
+                                    score = currentScore;
+                                    currentHighestFeature = j;
+                                }
+                            }/*raise the shared score*/
+                        }/*if the score is exact and may still win*/
+                    }/*if j is unselected*/
+                }/*for each candidate in order of relevance*/
+            }/*parallel lazy scoring of the candidates*/
+        } else {
+            #pragma omp parallel num_threads(numThreads) if (numThreads > 1)
+            {
+                double threadScore = -DBL_MAX;
+                int threadHighestFeature = 0;
+                JointStatistics stats;
+                double interaction;
+                int j;
+
+                #pragma omp for schedule(dynamic,FS_CHUNK_SIZE)
+                for (j = 0; j < noOfFeatures; j++) {
+                    /*if we haven't selected j*/
+                    if (!selectedFeatures[j]) {
+                        /*work out the interaction with the last selected feature*/
+
+                        /*JointStatistics calcJointStatistics(FSColumn *firstColumn, FSColumn *secondColumn, FSColumn *classColumn, int vectorLength);*/
+                        stats = calcJointStatistics(set->features + outputFeatures[i-1], set->features + j, &(set->classColumn), noOfSamples);
+                        interaction = stats.cmi - stats.mi;
+
+                        if (interaction < 0) {
+                            runningScores[j] += interaction;
+                        }
+
+                        if (BETTER_CANDIDATE(runningScores[j],j,threadScore,threadHighestFeature)) {
+                            threadScore = runningScores[j];
+                            threadHighestFeature = j;
+                        }
+                    }/*if j is unselected*/
+                }/*for number of features*/
+
+                #pragma omp critical (ICAPReduce)
+                {
+                    if (BETTER_CANDIDATE(threadScore,threadHighestFeature,score,currentHighestFeature)) {
+                        score = threadScore;
+                        currentHighestFeature = threadHighestFeature;
                     }
-                }/*for the number of already selected features*/
-
-                if (currentScore > score) {
-                    score = currentScore;
-                    currentHighestFeature = j;
-                }
-            }/*if j is unselected*/
-        }/*for number of features*/
+                }/*reduce the thread maxima*/
+            }/*parallel scoring of the candidates*/
+        }
 
         selectedFeatures[currentHighestFeature] = 1;
         outputFeatures[i] = currentHighestFeature;
@@ -146,47 +228,62 @@ uint* ICAP(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, ui
     }/*for the number of features to select*/
 
     FREE_FUNC(classMI);
-    FREE_FUNC(featureInteractionMatrix);
+    FREE_FUNC(runningScores);
     FREE_FUNC(selectedFeatures);
 
+    if (lazy) {
+        FREE_FUNC(lastUsedFeature);
+        FREE_FUNC(candidateOrder);
+        lastUsedFeature = NULL;
+        candidateOrder = NULL;
+    }
+
     classMI = NULL;
-    featureInteractionMatrix = NULL;
+    runningScores = NULL;
     selectedFeatures = NULL;
 
     return outputFeatures;
+}/*columnICAP(uint,FSColumnSet*,uint[],double[],FSOptions*)*/
+
+uint* ICAPWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores, FSOptions *options) {
+    FSColumnSet set;
+
+    createColumnSet(noOfSamples, noOfFeatures, featureMatrix, classColumn, options, &set);
+
+    columnICAP(k, &set, outputFeatures, featureScores, options);
+
+    freeColumnSet(&set);
+
+    return outputFeatures;
+}/*ICAPWithOptions(uint,uint,uint,uint[][],uint[],uint[],double[],FSOptions*)*/
+
+uint* ICAP(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores) {
+    return ICAPWithOptions(k, noOfSamples, noOfFeatures, featureMatrix, classColumn, outputFeatures, featureScores, NULL);
 }/*ICAP(uint,uint,uint,uint[][],uint[],uint[],double[])*/
 
+uint* datasetICAP(uint k, FEASTDataset *dataset, uint *outputFeatures, double *featureScores, FSOptions *options) {
+    columnICAP(searchLength(dataset,k), searchColumnSet(dataset), outputFeatures, featureScores, options);
+    return restoreFeatureIndices(dataset, k, outputFeatures, featureScores);
+}/*datasetICAP(uint,FEASTDataset*,uint[],double[],FSOptions*)*/
+
 double* discICAP(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *outputFeatures, double *featureScores) {
-    uint *intFeatures = (uint *) checkedCalloc(noOfSamples*noOfFeatures,sizeof(uint));
-    uint *intClass = (uint *) checkedCalloc(noOfSamples,sizeof(uint));
+    FSColumnSet set;
     uint *intOutputs = (uint *) checkedCalloc(k,sizeof(uint));
 
-    uint **intFeature2D = (uint**) checkedCalloc(noOfFeatures,sizeof(uint*));
-
     int i;
 
-    for (i = 0; i < noOfFeatures; i++) {
-        intFeature2D[i] = intFeatures + i*noOfSamples;
-        normaliseArray(featureMatrix[i],intFeature2D[i],noOfSamples);
-    }
-
-    normaliseArray(classColumn,intClass,noOfSamples);
+    normaliseColumnSet(noOfSamples, noOfFeatures, featureMatrix, classColumn, &set);
 
-    ICAP(k, noOfSamples, noOfFeatures, intFeature2D, intClass, intOutputs, featureScores);
+    columnICAP(k, &set, intOutputs, featureScores, NULL);
 
     for (i = 0; i < k; i++) {
         outputFeatures[i] = intOutputs[i];
     }
 
-    FREE_FUNC(intFeatures);
-    FREE_FUNC(intClass);
+    freeColumnSet(&set);
     FREE_FUNC(intOutputs);
-    FREE_FUNC(intFeature2D);
 
-    intFeatures = NULL;
-    intClass = NULL;
     intOutputs = NULL;
-    intFeature2D = NULL;
 
     return outputFeatures;
 }/*discICAP(int,int,int,double[][],double[],double[],double[])*/
@@ -6,6 +6,9 @@
 ** Updated - 22/02/2014 - Patched calloc.
 **           12/03/2016 - Changed initial value of maxMI to -1.0 to prevent segfaults when I(X;Y) = 0.0 for all X.
 **           17/12/2016 - Added feature scores.
+**           17/10/2026 - Moved the class MI calculation into the shared parallel relevance pass.
+**           17/10/2026 - Split out a column variant which reads compact 8/16 bit columns.
+**           17/10/2026 - Added the FEASTDataset entry point.
 **
 ** Author - Adam Pocock
 ** 
@@ -47,12 +50,14 @@
 
 #include "FEAST/FSAlgorithms.h"
 #include "FEAST/FSToolbox.h"
+#include "FSInternal.h"
 
 /* MIToolbox includes */
 #include "MIToolbox/ArrayOperations.h"
 #include "MIToolbox/MutualInformation.h"
 
-uint* MIM(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores) {
+uint* columnMIM(uint k, FSColumnSet *set, uint *outputFeatures, double *featureScores, FSOptions *options) {
+    uint noOfFeatures = set->noOfFeatures;
     char *selectedFeatures = (char *) checkedCalloc(noOfFeatures,sizeof(char));
 
     /*holds the class MI values*/
@@ -68,9 +73,9 @@ uint* MIM(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uin
      ** Algorithm starts here
      ***********************************************************/
 
-    for (i = 0; i < noOfFeatures; i++) {
-        classMI[i] = calcMutualInformation(featureMatrix[i], classColumn, noOfSamples);
+    calculateClassMI(set, classMI, options);
 
+    for (i = 0; i < noOfFeatures; i++) {
         if (classMI[i] > maxMI) {
             maxMI = classMI[i];
             maxMICounter = i;
@@ -107,39 +112,47 @@ uint* MIM(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uin
     selectedFeatures = NULL;
 
     return outputFeatures;
+}/*columnMIM(uint,FSColumnSet*,uint[],double[],FSOptions*)*/
+
+uint* MIMWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores, FSOptions *options) {
+    FSColumnSet set;
+
+    createColumnSet(noOfSamples, noOfFeatures, featureMatrix, classColumn, options, &set);
+
+    columnMIM(k, &set, outputFeatures, featureScores, options);
+
+    freeColumnSet(&set);
+
+    return outputFeatures;
+}/*MIMWithOptions(uint,uint,uint,uint[][],uint[],uint[],double[],FSOptions*)*/
+
+uint* MIM(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores) {
+    return MIMWithOptions(k, noOfSamples, noOfFeatures, featureMatrix, classColumn, outputFeatures, featureScores, NULL);
 }/*MIM(uint,uint,uint,uint[][],uint[],uint[],double[])*/
 
+uint* datasetMIM(uint k, FEASTDataset *dataset, uint *outputFeatures, double *featureScores, FSOptions *options) {
+    columnMIM(searchLength(dataset,k), searchColumnSet(dataset), outputFeatures, featureScores, options);
+    return restoreFeatureIndices(dataset, k, outputFeatures, featureScores);
+}/*datasetMIM(uint,FEASTDataset*,uint[],double[],FSOptions*)*/
+
 double* discMIM(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *outputFeatures, double *featureScores) {
-    uint *intFeatures = (uint *) checkedCalloc(noOfSamples*noOfFeatures,sizeof(uint));
-    uint *intClass = (uint *) checkedCalloc(noOfSamples,sizeof(uint));
+    FSColumnSet set;
     uint *intOutputs = (uint *) checkedCalloc(k,sizeof(uint));
 
-    uint **intFeature2D = (uint**) checkedCalloc(noOfFeatures,sizeof(uint*));
-
     int i;
 
-    for (i = 0; i < noOfFeatures; i++) {
-        intFeature2D[i] = intFeatures + i*noOfSamples;
-        normaliseArray(featureMatrix[i],intFeature2D[i],noOfSamples);
-    }
-
-    normaliseArray(classColumn,intClass,noOfSamples);
+    normaliseColumnSet(noOfSamples, noOfFeatures, featureMatrix, classColumn, &set);
 
-    MIM(k, noOfSamples, noOfFeatures, intFeature2D, intClass, intOutputs, featureScores);
+    columnMIM(k, &set, intOutputs, featureScores, NULL);
 
     for (i = 0; i < k; i++) {
         outputFeatures[i] = intOutputs[i];
     }
 
-    FREE_FUNC(intFeatures);
-    FREE_FUNC(intClass);
+    freeColumnSet(&set);
     FREE_FUNC(intOutputs);
-    FREE_FUNC(intFeature2D);
 
-    intFeatures = NULL;
-    intClass = NULL;
     intOutputs = NULL;
-    intFeature2D = NULL;
 
     return outputFeatures;
 }/*discMIM(int,int,int,double[][],double[],double[],double[])*/
@@ -11,6 +11,8 @@
 ** Initial Version - 13/06/2008
 ** Updated - 08/08/2011
 **           17/12/2016 - Added feature scores.
+**           17/10/2026 - Moved the class MI calculation into the shared parallel relevance pass.
+**           17/10/2026 - Parallelised the candidate loop, sharing the best score as the pruning bound.
 **
 ** Author - Adam Pocock
 ** 
@@ -51,12 +53,13 @@
 
 #include "FEAST/WeightedFSAlgorithms.h"
 #include "FEAST/FSToolbox.h"
+#include "FSInternal.h"
 
 /* MIToolbox includes */
 #include "MIToolbox/ArrayOperations.h"
 #include "MIToolbox/WeightedMutualInformation.h"
 
-uint* weightedCMIM(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, uint *outputFeatures, double *featureScores) {
+uint* weightedCMIMWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, uint *outputFeatures, double *featureScores, FSOptions *options) {
     /*holds the class MI values
      **the class MI doubles as the partial score from the CMIM paper
      */
@@ -64,17 +67,19 @@ uint* weightedCMIM(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMa
     /*in the CMIM paper, m = lastUsedFeature*/
     uint *lastUsedFeature = (uint *) checkedCalloc(noOfFeatures,sizeof(uint));
 
-    double score, conditionalInfo;
-    int currentFeature;
+    double score;
+    int currentHighestFeature;
+
+    int numThreads = numberOfThreads(options);
 
     double maxMI = 0.0;
     int maxMICounter = -1;
 
-    int j, i;
+    int i;
 
-    for (i = 0; i < noOfFeatures; i++) {
-        classMI[i] = calcWeightedMutualInformation(featureMatrix[i],classColumn,weightVector,noOfSamples);
+    calculateWeightedClassMI(noOfSamples, noOfFeatures, featureMatrix, classColumn, weightVector, classMI, options);
 
+    for (i = 0; i < noOfFeatures; i++) {
         if (classMI[i] > maxMI) {
             maxMI = classMI[i];
             maxMICounter = i;
@@ -92,24 +97,52 @@ uint* weightedCMIM(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMa
 
     for (i = 1; i < k; i++) {
         score = 0.0;
-
-        for (j = 0; j < noOfFeatures; j++) {
-            while ((classMI[j] > score) && (lastUsedFeature[j] < i)) {
-                /*double calcWeightedConditionalMutualInformation(uint *firstVector, uint *targetVector, uint *conditionVector, double *weightVector, int vectorLength);*/
-                currentFeature = outputFeatures[lastUsedFeature[j]];
-                conditionalInfo = calcWeightedConditionalMutualInformation(featureMatrix[j], classColumn, featureMatrix[currentFeature], weightVector, noOfSamples);
-                if (classMI[j] > conditionalInfo) {
-                    classMI[j] = conditionalInfo;
-                }/*reset classMI*/
-                /*moved due to C indexing from 0 rather than 1*/
-                lastUsedFeature[j] += 1;
-            }/*while partial score greater than score & not reached last feature*/
-            if (classMI[j] > score) {
-                score = classMI[j];
-                featureScores[i] = score;
-                outputFeatures[i] = j;
-            }/*if partial score still greater than score*/
-        }/*for number of features*/
+        currentHighestFeature = -1;
+
+        #pragma omp parallel num_threads(numThreads) if (numThreads > 1)
+        {
+            double bound, conditionalInfo;
+            int currentFeature;
+            int j;
+
+            #pragma omp for schedule(dynamic,FS_CHUNK_SIZE)
+            for (j = 0; j < noOfFeatures; j++) {
+                /*score is the best exact score any thread has found so far, so it only grows*/
+                #pragma omp atomic read
+                bound = score;
+
+                /*a partial score equal to the bound may still win on index, so only strictly lower ones stop*/
+                while ((classMI[j] > 0.0) && (classMI[j] >= bound) && (lastUsedFeature[j] < i)) {
+                    /*double calcWeightedConditionalMutualInformation(uint *firstVector, uint *targetVector, uint *conditionVector, double *weightVector, int vectorLength);*/
+                    currentFeature = outputFeatures[lastUsedFeature[j]];
+                    conditionalInfo = calcWeightedConditionalMutualInformation(featureMatrix[j], classColumn, featureMatrix[currentFeature], weightVector, noOfSamples);
+                    if (classMI[j] > conditionalInfo) {
+                        classMI[j] = conditionalInfo;
+                    }/*reset classMI*/
+                    /*moved due to C indexing from 0 rather than 1*/
+                    lastUsedFeature[j] += 1;
+
+                    #pragma omp atomic read
+                    bound = score;
+                }/*while partial score not below score & not reached last feature*/
+
+                if ((lastUsedFeature[j] == i) && (classMI[j] > 0.0) && (classMI[j] >= bound)) {
+                    #pragma omp critical (weightedCMIMScore)
+                    {
+                        if (BETTER_CANDIDATE(classMI[j],j,score,currentHighestFeature)) {
+                            #pragma omp atomic write
+                            score = classMI[j];
+                            currentHighestFeature = j;
+                        }
+                    }/*raise the shared score*/
+                }/*if the partial score is exact and may still win*/
+            }/*for number of features*/
+        }/*parallel scoring of the candidates*/
+
+        if (currentHighestFeature != -1) {
+            featureScores[i] = score;
+            outputFeatures[i] = currentHighestFeature;
+        }/*if any partial score was greater than zero*/
     }/*for the number of features to select*/
 
     FREE_FUNC(classMI);
@@ -119,6 +152,10 @@ uint* weightedCMIM(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMa
     lastUsedFeature = NULL;
 
     return outputFeatures;
+}/*weightedCMIMWithOptions(uint,uint,uint,uint[][],uint[],double[],uint[],double[],FSOptions*)*/
+
+uint* weightedCMIM(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, uint *outputFeatures, double *featureScores) {
+    return weightedCMIMWithOptions(k, noOfSamples, noOfFeatures, featureMatrix, classColumn, weightVector, outputFeatures, featureScores, NULL);
 }/*weightedCMIM(uint,uint,uint,uint[][],uint[],double[],uint[],double[])*/
 
 double* discWeightedCMIM(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *weightVector, double *outputFeatures, double *featureScores) {
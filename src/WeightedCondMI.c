@@ -5,6 +5,7 @@
 ** Initial Version - 19/08/2010
 ** Updated - 08/08/2011
 **           17/12/2016 - Added feature scores.
+**           17/10/2026 - Moved the class MI calculation into the shared parallel relevance pass.
 **
 ** Author - Adam Pocock
 ** 
@@ -45,6 +46,7 @@
 
 #include "FEAST/WeightedFSAlgorithms.h"
 #include "FEAST/FSToolbox.h"
+#include "FSInternal.h"
 
 /* for memcpy */
 #include <string.h>
@@ -53,7 +55,7 @@
 #include "MIToolbox/ArrayOperations.h"
 #include "MIToolbox/WeightedMutualInformation.h"
 
-int* weightedCondMI(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, int *outputFeatures, double *featureScores) {
+int* weightedCondMIWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, int *outputFeatures, double *featureScores, FSOptions *options) {
     char *selectedFeatures = (char *) checkedCalloc(noOfFeatures,sizeof(char));
 
     /*holds the class MI values*/
@@ -74,12 +76,9 @@ int* weightedCondMI(uint k, uint noOfSamples, uint noOfFeatures, uint **featureM
         outputFeatures[j] = -1;
     }
 
-    for (i = 0; i < noOfFeatures; i++) {
-        /*calculate mutual info
-         **double calcWeightedMutualInformation(uint *firstVector, uint *secondVector, uint *weightVector, int vectorLength);
-         */
-        classMI[i] = calcWeightedMutualInformation(featureMatrix[i],classColumn,weightVector,noOfSamples);
+    calculateWeightedClassMI(noOfSamples, noOfFeatures, featureMatrix, classColumn, weightVector, classMI, options);
 
+    for (i = 0; i < noOfFeatures; i++) {
         if (classMI[i] > maxMI) {
             maxMI = classMI[i];
             maxMICounter = i;
@@ -137,6 +136,10 @@ int* weightedCondMI(uint k, uint noOfSamples, uint noOfFeatures, uint **featureM
     selectedFeatures = NULL;
 
     return outputFeatures;
+}/*weightedCondMIWithOptions(uint,uint,uint,uint[][],uint[],double[],int[],double[],FSOptions*)*/
+
+int* weightedCondMI(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, int *outputFeatures, double *featureScores) {
+    return weightedCondMIWithOptions(k, noOfSamples, noOfFeatures, featureMatrix, classColumn, weightVector, outputFeatures, featureScores, NULL);
 }/*weightedCondMI(uint,uint,uint,uint[][],uint[],double[],int[],double[])*/
 
 double* discWeightedCondMI(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *weightVector, double *outputFeatures, double *featureScores) {
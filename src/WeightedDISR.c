@@ -10,6 +10,8 @@
 ** Initial Version - 13/06/2008
 ** Updated - 08/08/2011
 **           17/12/2016 - Added feature scores.
+**           17/10/2026 - Moved the class MI calculation into the shared parallel relevance pass.
+**           17/10/2026 - Replaced the k*noOfFeatures MI cache with a running score per feature.
 **
 ** Author - Adam Pocock
 ** 
@@ -49,46 +51,38 @@
 *******************************************************************************/
 #include "FEAST/WeightedFSAlgorithms.h"
 #include "FEAST/FSToolbox.h"
+#include "FSInternal.h"
 
 /* MIToolbox includes */
 #include "MIToolbox/WeightedMutualInformation.h"
 #include "MIToolbox/WeightedEntropy.h"
 #include "MIToolbox/ArrayOperations.h"
 
-uint* weightedDISR(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, uint *outputFeatures, double *featureScores) {
+uint* weightedDISRWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, uint *outputFeatures, double *featureScores, FSOptions *options) {
     char *selectedFeatures = (char *) checkedCalloc(noOfFeatures,sizeof(char));
 
     /*holds the class MI values*/
     double *classMI = (double *) checkedCalloc(noOfFeatures,sizeof(double));
 
-    /*holds the intra feature MI values*/
-    int sizeOfMatrix = k*noOfFeatures;
-    double *featureMIMatrix = (double *) checkedCalloc(sizeOfMatrix,sizeof(double));
+    /*holds the DISR score of each feature, which gains one term per iteration*/
+    double *runningScores = (double *) checkedCalloc(noOfFeatures,sizeof(double));
 
     /*Changed to ensure it always picks a feature*/
     double maxMI = -1.0;
     int maxMICounter = -1;
 
-    double score, currentScore;
+    double score;
     int currentHighestFeature;
 
     uint *mergedVector = (uint *) checkedCalloc(noOfSamples,sizeof(uint));
 
-    int arrayPosition;
     double mi, tripEntropy;
 
-    int i, j, x;
+    int i, j;
 
-    for (i = 0; i < sizeOfMatrix; i++) {
-        featureMIMatrix[i] = -1;
-    }/*for featureMIMatrix - blank to -1*/
+    calculateWeightedClassMI(noOfSamples, noOfFeatures, featureMatrix, classColumn, weightVector, classMI, options);
 
     for (i = 0; i < noOfFeatures; i++) {
-        /*calculate mutual info
-         **double calcWeightedMutualInformation(uint *firstVector, uint *secondVector, double *weightVector, int vectorLength);
-         */
-        classMI[i] = calcWeightedMutualInformation(featureMatrix[i], classColumn, weightVector, noOfSamples);
-
         if (classMI[i] > maxMI) {
             maxMI = classMI[i];
             maxMICounter = i;
@@ -108,32 +102,23 @@ uint* weightedDISR(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMa
     for (i = 1; i < k; i++) {
         score = 0.0;
         currentHighestFeature = 0;
-        currentScore = 0.0;
 
         for (j = 0; j < noOfFeatures; j++) {
             /*if we haven't selected j*/
             if (selectedFeatures[j] == 0) {
-                currentScore = 0.0;
-
-                for (x = 0; x < i; x++) {
-                    arrayPosition = x * noOfFeatures + j;
-                    if (featureMIMatrix[arrayPosition] == -1) {
-                        /*
-                         **double calcWeightedMutualInformation(uint *firstVector, uint *secondVector, double *weightVector, int vectorLength);
-                         **double calcWeightedJointEntropy(uint *firstVector, uint *secondVector, double *weightVector, int vectorLength);
-                         */
-
-                        mergeArrays(featureMatrix[outputFeatures[x]], featureMatrix[j], mergedVector, noOfSamples);
-                        mi = calcWeightedMutualInformation(mergedVector, classColumn, weightVector, noOfSamples);
-                        tripEntropy = calcWeightedJointEntropy(mergedVector, classColumn, weightVector, noOfSamples);
-
-                        featureMIMatrix[arrayPosition] = mi / tripEntropy;
-                    }/*if not already known*/
-                    currentScore += featureMIMatrix[arrayPosition];
-                }/*for the number of already selected features*/
-
-                if (currentScore > score) {
-                    score = currentScore;
+                /*only the term for the last selected feature is new*/
+                /*
+                 **double calcWeightedMutualInformation(uint *firstVector, uint *secondVector, double *weightVector, int vectorLength);
+                 **double calcWeightedJointEntropy(uint *firstVector, uint *secondVector, double *weightVector, int vectorLength);
+                 */
+                mergeArrays(featureMatrix[outputFeatures[i-1]], featureMatrix[j], mergedVector, noOfSamples);
+                mi = calcWeightedMutualInformation(mergedVector, classColumn, weightVector, noOfSamples);
+                tripEntropy = calcWeightedJointEntropy(mergedVector, classColumn, weightVector, noOfSamples);
+
+                runningScores[j] += mi / tripEntropy;
+
+                if (runningScores[j] > score) {
+                    score = runningScores[j];
                     currentHighestFeature = j;
                 }
             }/*if j is unselected*/
@@ -147,15 +132,19 @@ uint* weightedDISR(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMa
 
     FREE_FUNC(classMI);
     FREE_FUNC(mergedVector);
-    FREE_FUNC(featureMIMatrix);
+    FREE_FUNC(runningScores);
     FREE_FUNC(selectedFeatures);
 
     classMI = NULL;
     mergedVector = NULL;
-    featureMIMatrix = NULL;
+    runningScores = NULL;
     selectedFeatures = NULL;
 
     return outputFeatures;
+}/*weightedDISRWithOptions(uint,uint,uint,uint[][],uint[],double[],uint[],double[],FSOptions*)*/
+
+uint* weightedDISR(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, uint *outputFeatures, double *featureScores) {
+    return weightedDISRWithOptions(k, noOfSamples, noOfFeatures, featureMatrix, classColumn, weightVector, outputFeatures, featureScores, NULL);
 }/*weightedDISR(uint,uint,uint,uint[][],uint[],double[],uint[],double[])*/
 
 double* discWeightedDISR(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *weightVector, double *outputFeatures, double *featureScores) {
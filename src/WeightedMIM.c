@@ -4,6 +4,7 @@
 ** mutual informations.
 **
 ** Initial Version - 07/01/2017
+** Updated - 17/10/2026 - Moved the class MI calculation into the shared parallel relevance pass.
 **
 ** Author - Adam Pocock
 ** 
@@ -44,12 +45,13 @@
 
 #include "FEAST/WeightedFSAlgorithms.h"
 #include "FEAST/FSToolbox.h"
+#include "FSInternal.h"
 
 /* MIToolbox includes */
 #include "MIToolbox/ArrayOperations.h"
 #include "MIToolbox/WeightedMutualInformation.h"
 
-uint* weightedMIM(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, uint *outputFeatures, double *featureScores) {
+uint* weightedMIMWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, uint *outputFeatures, double *featureScores, FSOptions *options) {
     char *selectedFeatures = (char *) checkedCalloc(noOfFeatures,sizeof(char));
 
     /*holds the class MI values*/
@@ -65,12 +67,9 @@ uint* weightedMIM(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMat
      ** Algorithm starts here
      ***********************************************************/
 
-    for (i = 0; i < noOfFeatures; i++) {
-        /*calculate mutual info
-         **double calcWeightedMutualInformation(uint *firstVector, uint *secondVector, double *weightVector int vectorLength);
-         */
-        classMI[i] = calcWeightedMutualInformation(featureMatrix[i], classColumn, weightVector, noOfSamples);
+    calculateWeightedClassMI(noOfSamples, noOfFeatures, featureMatrix, classColumn, weightVector, classMI, options);
 
+    for (i = 0; i < noOfFeatures; i++) {
         if (classMI[i] > maxMI) {
             maxMI = classMI[i];
             maxMICounter = i;
@@ -106,7 +105,11 @@ uint* weightedMIM(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMat
     selectedFeatures = NULL;
 
     return outputFeatures;
-}/*WeightedMIM(uint,uint,uint,uint[][],uint[],double[],uint[],double[])*/
+}/*weightedMIMWithOptions(uint,uint,uint,uint[][],uint[],double[],uint[],double[],FSOptions*)*/
+
+uint* weightedMIM(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, double *weightVector, uint *outputFeatures, double *featureScores) {
+    return weightedMIMWithOptions(k, noOfSamples, noOfFeatures, featureMatrix, classColumn, weightVector, outputFeatures, featureScores, NULL);
+}/*weightedMIM(uint,uint,uint,uint[][],uint[],double[],uint[],double[])*/
 
 double* discWeightedMIM(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *weightVector, double *outputFeatures, double *featureScores) {
     uint *intFeatures = (uint *) checkedCalloc(noOfSamples*noOfFeatures,sizeof(uint));
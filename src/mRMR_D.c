@@ -11,6 +11,12 @@
 **           22/02/2014 - Patched calloc.
 **           12/03/2016 - Changed initial value of maxMI to -1.0 to prevent segfaults when I(X;Y) = 0.0 for all X.
 **           17/12/2016 - Added feature scores.
+**           17/10/2026 - Added multi-threaded candidate scoring.
+**           17/10/2026 - Moved the class MI calculation into the shared parallel relevance pass.
+**           17/10/2026 - Replaced the k*noOfFeatures MI cache with a running score per feature.
+**           17/10/2026 - Split out a column variant which reads compact 8/16 bit columns.
+**           17/10/2026 - Added the FEASTDataset entry point.
+**           17/10/2026 - Added lazy evaluation, pruning candidates whose partial score is below the best.
 **
 ** Author - Adam Pocock
 ** 
@@ -52,18 +58,20 @@
 
 #include "FEAST/FSAlgorithms.h"
 #include "FEAST/FSToolbox.h"
+#include "FSInternal.h"
 
 /* MIToolbox includes */
 #include "MIToolbox/ArrayOperations.h"
 #include "MIToolbox/MutualInformation.h"
 
-uint* mRMR_D(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores) {
+uint* columnmRMR_D(uint k, FSColumnSet *set, uint *outputFeatures, double *featureScores, FSOptions *options) {
+    uint noOfSamples = set->noOfSamples;
+    uint noOfFeatures = set->noOfFeatures;
     /*holds the class MI values*/
     double *classMI = (double *) checkedCalloc(noOfFeatures,sizeof(double));
     char *selectedFeatures = (char *) checkedCalloc(noOfFeatures,sizeof(char));
-    /*holds the intra feature MI values*/
-    int sizeOfMatrix = k*noOfFeatures;
-    double *featureMIMatrix = (double *) checkedCalloc(sizeOfMatrix,sizeof(double));
+    /*holds the sum of the intra feature MI values for each feature*/
+    double *totalFeatureMI = (double *) checkedCalloc(noOfFeatures,sizeof(double));
 
     /*Changed to ensure it always picks a feature*/
     double maxMI = -1.0;
@@ -71,17 +79,23 @@ uint* mRMR_D(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix,
 
     /*init variables*/
 
-    double score, currentScore, totalFeatureMI;
+    double score;
     int currentHighestFeature;
 
-    int arrayPosition, i, j, x;
+    int numThreads = numberOfThreads(options);
+
+    /*lazy evaluation only calculates the terms a candidate needs to beat the best score*/
+    int lazy = (options != NULL) && options->lazyEvaluation;
+    /*the number of selected features whose terms are in each running score*/
+    uint *lastUsedFeature = NULL;
+    /*the candidates in descending order of class MI*/
+    int *candidateOrder = NULL;
+
+    int i;
 
-    for (i = 0; i < sizeOfMatrix; i++) {
-        featureMIMatrix[i] = -1;
-    }/*for featureMIMatrix - blank to -1*/
+    calculateClassMI(set, classMI, options);
 
     for (i = 0; i < noOfFeatures; i++) {
-        classMI[i] = calcMutualInformation(featureMatrix[i], classColumn, noOfSamples);
         if (classMI[i] > maxMI) {
             maxMI = classMI[i];
             maxMICounter = i;
@@ -92,6 +106,11 @@ uint* mRMR_D(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix,
     outputFeatures[0] = maxMICounter;
     featureScores[0] = maxMI;
 
+    if (lazy) {
+        lastUsedFeature = (uint *) checkedCalloc(noOfFeatures,sizeof(uint));
+        candidateOrder = rankByScore(classMI, noOfFeatures);
+    }
+
     /*************
      ** Now we have populated the classMI array, and selected the highest
      ** MI feature as the first output feature
@@ -106,33 +125,86 @@ uint* mRMR_D(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix,
         ****************************************************/
         score = -DBL_MAX;
         currentHighestFeature = 0;
-        currentScore = 0.0;
-        totalFeatureMI = 0.0;
-
-        for (j = 0; j < noOfFeatures; j++) {
-            /*if we haven't selected j*/
-            if (selectedFeatures[j] == 0) {
-                currentScore = classMI[j];
-                totalFeatureMI = 0.0;
-
-                for (x = 0; x < i; x++) {
-                    arrayPosition = x * noOfFeatures + j;
-                    if (featureMIMatrix[arrayPosition] == -1) {
-                        /*work out intra MI*/
-                        /*double calcMutualInformation(uint *firstVector, uint *secondVector, int vectorLength);*/
-                        featureMIMatrix[arrayPosition] = calcMutualInformation(featureMatrix[outputFeatures[x]], featureMatrix[j], noOfSamples);
-                    }
 
-                    totalFeatureMI += featureMIMatrix[arrayPosition];
-                }/*for the number of already selected features*/
+        if (lazy) {
+            #pragma omp parallel num_threads(numThreads) if (numThreads > 1)
+            {
+                double currentScore, bound;
+                int j, o;
+
+                #pragma omp for schedule(dynamic,FS_CHUNK_SIZE)
+                for (o = 0; o < noOfFeatures; o++) {
+                    j = candidateOrder[o];
+                    /*if we haven't selected j*/
+                    if (!selectedFeatures[j]) {
+                        /*score is the best exact score found so far, so it only grows*/
+                        #pragma omp atomic read
+                        bound = score;
+
+                        currentScore = classMI[j];
+                        currentScore -= (totalFeatureMI[j] / i);
+
+                        /*the missing MI terms are non-negative up to rounding, so with a slack for each the partial sum bounds the final score*/
+                        while ((currentScore + (FS_BOUND_TOLERANCE * (i - lastUsedFeature[j])) / i >= bound) && (lastUsedFeature[j] < i)) {
+                            /*double calcColumnMI(FSColumn *firstColumn, FSColumn *secondColumn, int vectorLength);*/
+                            totalFeatureMI[j] += calcColumnMI(set->features + outputFeatures[lastUsedFeature[j]], set->features + j, noOfSamples);
+
+                            lastUsedFeature[j] += 1;
+                            currentScore = classMI[j];
+                            currentScore -= (totalFeatureMI[j] / i);
+
+                            #pragma omp atomic read
+                            bound = score;
+                        }/*while the bound may still win & terms are missing*/
+
+                        if ((lastUsedFeature[j] == i) && (currentScore >= bound)) {
+                            #pragma omp critical (mRMR_DScore)
+                            {
+                                if (BETTER_CANDIDATE(currentScore,j,score,currentHighestFeature)) {
+                                    #pragma omp atomic write
+                                    score = currentScore;
+                                    currentHighestFeature = j;
+                                }
+                            }/*raise the shared score*/
+                        }/*if the score is exact and may still win*/
+                    }/*if j is unselected*/
+                }/*for each candidate in order of relevance*/
+            }/*parallel lazy scoring of the candidates*/
+        } else {
+            #pragma omp parallel num_threads(numThreads) if (numThreads > 1)
+            {
+                double threadScore = -DBL_MAX;
+                int threadHighestFeature = 0;
+                double currentScore;
+                int j;
+
+                #pragma omp for schedule(dynamic,FS_CHUNK_SIZE)
+                for (j = 0; j < noOfFeatures; j++) {
+                    /*if we haven't selected j*/
+                    if (selectedFeatures[j] == 0) {
+                        currentScore = classMI[j];
+
+                        /*work out intra MI with the last selected feature*/
+                        /*double calcColumnMI(FSColumn *firstColumn, FSColumn *secondColumn, int vectorLength);*/
+                        totalFeatureMI[j] += calcColumnMI(set->features + outputFeatures[i-1], set->features + j, noOfSamples);
+
+                        currentScore -= (totalFeatureMI[j] / i);
+                        if (BETTER_CANDIDATE(currentScore,j,threadScore,threadHighestFeature)) {
+                            threadScore = currentScore;
+                            threadHighestFeature = j;
+                        }
+                    }/*if j is unselected*/
+                }/*for number of features*/
 
-                currentScore -= (totalFeatureMI / i);
-                if (currentScore > score) {
-                    score = currentScore;
-                    currentHighestFeature = j;
-                }
-            }/*if j is unselected*/
-        }/*for number of features*/
+                #pragma omp critical (mRMR_DReduce)
+                {
+                    if (BETTER_CANDIDATE(threadScore,threadHighestFeature,score,currentHighestFeature)) {
+                        score = threadScore;
+                        currentHighestFeature = threadHighestFeature;
+                    }
+                }/*reduce the thread maxima*/
+            }/*parallel scoring of the candidates*/
+        }
 
         selectedFeatures[currentHighestFeature] = 1;
         outputFeatures[i] = currentHighestFeature;
@@ -141,47 +213,62 @@ uint* mRMR_D(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix,
     }/*for the number of features to select*/
 
     FREE_FUNC(classMI);
-    FREE_FUNC(featureMIMatrix);
+    FREE_FUNC(totalFeatureMI);
     FREE_FUNC(selectedFeatures);
 
+    if (lazy) {
+        FREE_FUNC(lastUsedFeature);
+        FREE_FUNC(candidateOrder);
+        lastUsedFeature = NULL;
+        candidateOrder = NULL;
+    }
+
     classMI = NULL;
-    featureMIMatrix = NULL;
+    totalFeatureMI = NULL;
     selectedFeatures = NULL;
 
     return outputFeatures;
-}
+}/*columnmRMR_D(uint,FSColumnSet*,uint[],double[],FSOptions*)*/
+
+uint* mRMR_DWithOptions(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores, FSOptions *options) {
+    FSColumnSet set;
+
+    createColumnSet(noOfSamples, noOfFeatures, featureMatrix, classColumn, options, &set);
+
+    columnmRMR_D(k, &set, outputFeatures, featureScores, options);
+
+    freeColumnSet(&set);
+
+    return outputFeatures;
+}/*mRMR_DWithOptions(uint,uint,uint,uint[][],uint[],uint[],double[],FSOptions*)*/
+
+uint* mRMR_D(uint k, uint noOfSamples, uint noOfFeatures, uint **featureMatrix, uint *classColumn, uint *outputFeatures, double *featureScores) {
+    return mRMR_DWithOptions(k, noOfSamples, noOfFeatures, featureMatrix, classColumn, outputFeatures, featureScores, NULL);
+}/*mRMR_D(uint,uint,uint,uint[][],uint[],uint[],double[])*/
+
+uint* datasetmRMR_D(uint k, FEASTDataset *dataset, uint *outputFeatures, double *featureScores, FSOptions *options) {
+    columnmRMR_D(searchLength(dataset,k), searchColumnSet(dataset), outputFeatures, featureScores, options);
+    return restoreFeatureIndices(dataset, k, outputFeatures, featureScores);
+}/*datasetmRMR_D(uint,FEASTDataset*,uint[],double[],FSOptions*)*/
 
 double* disc_mRMR_D(uint k, uint noOfSamples, uint noOfFeatures, double **featureMatrix, double *classColumn, double *outputFeatures, double *featureScores) {
-    uint *intFeatures = (uint *) checkedCalloc(noOfSamples*noOfFeatures,sizeof(uint));
-    uint *intClass = (uint *) checkedCalloc(noOfSamples,sizeof(uint));
+    FSColumnSet set;
     uint *intOutputs = (uint *) checkedCalloc(k,sizeof(uint));
 
-    uint **intFeature2D = (uint**) checkedCalloc(noOfFeatures,sizeof(uint*));
-
     int i;
 
-    for (i = 0; i < noOfFeatures; i++) {
-        intFeature2D[i] = intFeatures + i*noOfSamples;
-        normaliseArray(featureMatrix[i],intFeature2D[i],noOfSamples);
-    }
-
-    normaliseArray(classColumn,intClass,noOfSamples);
+    normaliseColumnSet(noOfSamples, noOfFeatures, featureMatrix, classColumn, &set);
 
-    mRMR_D(k, noOfSamples, noOfFeatures, intFeature2D, intClass, intOutputs, featureScores);
+    columnmRMR_D(k, &set, intOutputs, featureScores, NULL);
 
     for (i = 0; i < k; i++) {
         outputFeatures[i] = intOutputs[i];
     }
 
-    FREE_FUNC(intFeatures);
-    FREE_FUNC(intClass);
+    freeColumnSet(&set);
     FREE_FUNC(intOutputs);
-    FREE_FUNC(intFeature2D);
 
-    intFeatures = NULL;
-    intClass = NULL;
     intOutputs = NULL;
-    intFeature2D = NULL;
 
     return outputFeatures;
 }/*disc_mRMR_D(int,int,int,double[][],double[],double[],double[])*/